@@ -26,7 +26,6 @@
  */
 
 #include <algorithm>
-#include <queue>
 
 #include "ft-client.hpp"
 #include "logger/logger.hpp"
@@ -36,6 +35,7 @@ Client::Client(std::shared_ptr<ndnc::posix::Consumer> consumer,
                ClientOptions options)
     : stop_{false}, error_{false}, consumer_{consumer}, options_{options} {
     files_ = std::make_shared<std::unordered_map<std::string, uint64_t>>();
+    listing_ = std::make_shared<ndnc::posix::Listing>(consumer_);
 }
 
 Client::~Client() {
@@ -94,152 +94,83 @@ void Client::listFile(std::string path,
     metadata = std::make_shared<ndnc::posix::FileMetadata>(data->getContent());
 }
 
-void Client::listDir(
-    std::string root,
-    std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all) {
-    std::shared_ptr<ndnc::posix::FileMetadata> metadata(nullptr);
-    all.clear();
-
-    {
-        // Get list dir Metadata
-        auto interest = std::make_shared<ndn::Interest>(
-            ndnc::posix::rdrDiscoveryNameDirListing(root,
-                                                    options_.consumer.prefix));
-
-        interest->setCanBePrefix(true);
-        interest->setMustBeFresh(true);
-
-        auto data = consumer_->syncRequestDataFor(std::move(interest), 0);
-
-        if (data == nullptr || !data->hasContent()) {
-            LOG_ERROR("invalid data");
-            error_ = true;
-            return;
-        }
-
-        if (data->getContentType() == ndn::tlv::ContentType_Nack) {
-            LOG_ERROR("unable to list dir: '%s'", root.c_str());
-            return;
-        }
-
-        metadata =
-            std::make_shared<ndnc::posix::FileMetadata>(data->getContent());
-    }
+bool Client::listDirEntries(std::string root,
+                            std::vector<std::string> &paths) {
+    // Get list dir Metadata
+    auto metadata = listing_->getMetadata(root, 0, true);
 
     if (metadata == nullptr) {
         LOG_ERROR("unable to list dir: '%s'", root.c_str());
-        return;
+        return false;
     }
 
     if (!metadata->isDir()) {
         LOG_ERROR("request to list dir on a file path: '%s'", root.c_str());
-        return;
+        return false;
     }
 
-    uint8_t *byteContent =
-        (uint8_t *)malloc(8800 * (metadata->getFinalBlockID() + 1));
-
-    if (NULL == byteContent) {
-        LOG_FATAL("unable to allocate memory for retrieving dir list content");
+    // Get all list dir content
+    std::vector<std::string> entries;
+    if (!listing_->getEntries(metadata, 0, entries)) {
+        LOG_ERROR("unable to get list dir content '%s'", root.c_str());
         error_ = true;
-        return;
+        return false;
     }
 
-    uint64_t byteContentOffset = 0;
-    uint64_t contentFinalBlockId = 0;
-    {
-        // Get all list dir content
-        for (uint64_t i = 0; i <= contentFinalBlockId; ++i) {
-            auto interest = std::make_shared<ndn::Interest>(
-                metadata->getVersionedName().appendSegment(i));
-
-            auto data = consumer_->syncRequestDataFor(std::move(interest), 0);
-
-            if (data == nullptr || !data->hasContent()) {
-                LOG_ERROR("invalid data");
-                error_ = true;
-                return;
-            }
-
-            if (data->getContentType() == ndn::tlv::ContentType_Nack) {
-                LOG_FATAL("unable to get list dir content '%s'", root.c_str());
-                error_ = true;
-                return;
-            } else {
-                if (!data->getFinalBlock()->isSegment()) {
-                    LOG_ERROR(
-                        "dir list data content FinalBlockId is not a segment");
-                    error_ = true;
-                    return;
-                } else {
-                    contentFinalBlockId = data->getFinalBlock()->toSegment();
-                }
-            }
-
-            memcpy(byteContent + byteContentOffset, data->getContent().value(),
-                   data->getContent().value_size());
-            byteContentOffset += data->getContent().value_size();
-        }
+    auto prefix = root.back() == '/' ? root : root + "/";
+    for (auto &entry : entries) {
+        paths.push_back(prefix + entry);
     }
 
-    // Parse dir list byteContent to a list of paths
-    std::vector<std::string> content = {};
-    for (uint64_t i = 0, j = 0;
-         j <= byteContentOffset && i <= byteContentOffset; ++j) {
-        if (byteContent[j] != '\0') {
-            continue;
-        }
-
-        if (byteContent[i] == '\0') {
-            break;
-        }
+    return true;
+}
 
-        auto suffix = std::string((const char *)(byteContent + i), j - i);
-        auto prefix = root.back() == '/' ? root : root + "/";
+void Client::listDir(
+    std::string root,
+    std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all) {
+    all.clear();
 
-        content.push_back(prefix + suffix);
-        i = j + 1;
+    std::vector<std::string> paths;
+    if (!listDirEntries(root, paths)) {
+        return;
     }
 
-    free(byteContent);
-
-    // Request Metadata for all files in the directory
-    for (auto file : content) {
-        metadata = nullptr;
-        listFile(file, metadata);
-
+    // Request Metadata for all files in the directory at once
+    for (auto metadata : listing_->getMetadata(paths, 0)) {
         if (metadata == nullptr) {
             LOG_ERROR("null metadata");
             continue;
-        } else {
-            all.push_back(metadata);
         }
+
+        all.push_back(metadata);
     }
 }
 
 void Client::listDirRecursive(
     std::string root,
     std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> &all) {
-    std::queue<std::string> paths;
-    paths.push(root);
-
-    while (!paths.empty()) {
-        auto path = paths.front();
-        paths.pop();
-
-        std::vector<std::shared_ptr<ndnc::posix::FileMetadata>> metadata{};
-        listDir(path, metadata);
-
-        if (metadata.empty()) {
-            continue;
+    std::vector<std::string> dirs{root};
+
+    // Walk the tree one level at a time, requesting the Metadata of all
+    // entries of a level at once
+    while (!dirs.empty() && this->canContinue()) {
+        std::vector<std::string> paths;
+        for (auto &dir : dirs) {
+            listDirEntries(dir, paths);
         }
+        dirs.clear();
+
+        for (auto md : listing_->getMetadata(paths, 0)) {
+            if (md == nullptr) {
+                LOG_ERROR("null metadata");
+                continue;
+            }
 
-        for (auto md : metadata) {
             all.push_back(md);
 
             if (md->isDir()) {
-                paths.push(ndnc::posix::rdrDirUri(md->getVersionedName(),
-                                                  options_.consumer.prefix));
+                dirs.push_back(ndnc::posix::rdrDirUri(
+                    md->getVersionedName(), options_.consumer.prefix));
             }
         }
     }
@@ -256,37 +187,17 @@ void Client::listDirRecursive(
 
 void Client::requestFileContent(
     std::shared_ptr<ndnc::posix::FileMetadata> metadata) {
-    uint64_t npkts = 64;
     uint64_t id = files_->at(metadata->getVersionedName().toUri());
 
-    for (uint64_t segmentNo = 0;
-         segmentNo <= metadata->getFinalBlockID() && this->canContinue();) {
-
-        // if (m_pipeline->getQueuedInterestsCount() > 65536) {
-        //     // backoff; plenty of work to be done by the pipeline
-        //     continue;
-        // }
-
-        std::vector<std::shared_ptr<ndn::Interest>> pkts;
-        pkts.reserve(npkts);
-
-        for (uint64_t nextSegment = segmentNo, n = 0;
-             nextSegment <= metadata->getFinalBlockID() && n < npkts;
-             ++nextSegment, ++n) {
-
-            auto interest = std::make_shared<ndn::Interest>(
-                metadata->getVersionedName().deepCopy().appendSegment(
-                    nextSegment));
-
-            pkts.emplace_back(std::move(interest));
-        }
-
-        if (!consumer_->asyncRequestDataFor(std::move(pkts), id)) {
-            error_ = true;
-            return;
-        }
+    if (!this->canContinue()) {
+        return;
+    }
 
-        segmentNo += npkts;
+    // The pipeline generates the Interest packets as its window opens
+    if (!consumer_->asyncRequestSegmentRange(metadata->getVersionedName(), 0,
+                                             metadata->getFinalBlockID(), id)) {
+        error_ = true;
+        return;
     }
 }
 
@@ -33,6 +33,7 @@
 #include "../common/ft-naming-scheme.hpp"
 #include "lib/posix/file-metadata.hpp"
 #include "lib/posix/file-rdr.hpp"
+#include "lib/posix/listing.hpp"
 
 namespace ndnc::app::filetransfer {
 struct ClientOptions {
@@ -73,6 +74,7 @@ class Client : public std::enable_shared_from_this<Client> {
 
   private:
     bool canContinue();
+    bool listDirEntries(std::string root, std::vector<std::string> &paths);
 
   private:
     std::atomic_bool stop_;
@@ -81,6 +83,7 @@ class Client : public std::enable_shared_from_this<Client> {
     std::shared_ptr<ndnc::posix::Consumer> consumer_;
     ClientOptions options_;
     std::shared_ptr<std::unordered_map<std::string, uint64_t>> files_;
+    std::shared_ptr<ndnc::posix::Listing> listing_;
 };
 }; // namespace ndnc::app::filetransfer
 
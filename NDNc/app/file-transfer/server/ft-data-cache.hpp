@@ -0,0 +1,90 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_DATA_CACHE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_DATA_CACHE_HPP
+
+#include <list>
+#include <unordered_map>
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/name.hpp>
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief LRU cache of wire-encoded Data packets by Name, without the LP
+ * header. Content Names carry the file version, so an entry never goes stale
+ *
+ */
+class DataCache {
+  public:
+    DataCache(size_t capacity = 0) : capacity_{capacity} {
+    }
+
+    /**
+     * @brief Get the wire encoding of a Data packet
+     *
+     * @param name The Data Name
+     * @param wire The Data wire encoding
+     * @return true The Data is cached
+     * @return false The Data is not cached
+     */
+    bool get(const ndn::Name &name, ndn::Block &wire) {
+        auto it = index_.find(name);
+        if (it == index_.end()) {
+            return false;
+        }
+
+        lru_.splice(lru_.begin(), lru_, it->second);
+        wire = it->second->second;
+        return true;
+    }
+
+    void insert(const ndn::Name &name, const ndn::Block &wire) {
+        if (capacity_ == 0 || index_.find(name) != index_.end()) {
+            return;
+        }
+
+        if (lru_.size() >= capacity_) {
+            index_.erase(lru_.back().first);
+            lru_.pop_back();
+        }
+
+        lru_.emplace_front(name, wire);
+        index_[name] = lru_.begin();
+    }
+
+  private:
+    using Entries = std::list<std::pair<ndn::Name, ndn::Block>>;
+
+    size_t capacity_;
+    Entries lru_;
+    std::unordered_map<ndn::Name, Entries::iterator> index_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_DATA_CACHE_HPP
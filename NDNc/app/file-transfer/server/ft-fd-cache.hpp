@@ -0,0 +1,128 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_FD_CACHE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_FD_CACHE_HPP
+
+#include <fcntl.h>
+#include <list>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace ndnc::app::filetransfer {
+struct OpenFile {
+    int fd;
+    uint64_t mtime; // nanoseconds since Unix epoch, as in the Name version
+    uint64_t size;
+};
+
+/**
+ * @brief LRU cache of open file descriptors by path. Files are reopened when
+ * their size or modification time changed, so that stale descriptors of
+ * replaced files are never used
+ *
+ */
+class FdCache {
+  public:
+    FdCache(size_t capacity = 256) : capacity_{capacity} {
+    }
+
+    ~FdCache() {
+        for (auto &entry : lru_) {
+            ::close(entry.second.fd);
+        }
+    }
+
+    /**
+     * @brief Get an open file descriptor
+     *
+     * @param path The file path
+     * @param file The open file
+     * @return true The file is open
+     * @return false Unable to open the file or not a regular file
+     */
+    bool get(const std::string &path, OpenFile &file) {
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+            erase(path);
+            return false;
+        }
+
+        auto mtime = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                     st.st_mtim.tv_nsec;
+
+        if (auto it = index_.find(path); it != index_.end()) {
+            auto &cached = it->second->second;
+
+            if (cached.mtime == mtime &&
+                cached.size == static_cast<uint64_t>(st.st_size)) {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                file = cached;
+                return true;
+            }
+
+            erase(path);
+        }
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        if (lru_.size() >= capacity_ && !lru_.empty()) {
+            erase(lru_.back().first);
+        }
+
+        file = OpenFile{fd, mtime, static_cast<uint64_t>(st.st_size)};
+        lru_.emplace_front(path, file);
+        index_[path] = lru_.begin();
+        return true;
+    }
+
+    void erase(const std::string &path) {
+        auto it = index_.find(path);
+        if (it == index_.end()) {
+            return;
+        }
+
+        ::close(it->second->second.fd);
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+  private:
+    using Entries = std::list<std::pair<std::string, OpenFile>>;
+
+    size_t capacity_;
+    Entries lru_;
+    std::unordered_map<std::string, Entries::iterator> index_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_FD_CACHE_HPP
@@ -0,0 +1,220 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_LISTING_CACHE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_LISTING_CACHE_HPP
+
+#include <algorithm>
+#include <dirent.h>
+#include <fcntl.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/buffer.hpp>
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief The listing of a directory, one NUL-terminated entry per child with
+ * a trailing '/' for directories, as Content blocks of one segment size
+ *
+ */
+struct DirListing {
+    uint64_t version; // directory mtime in nanoseconds, as in the Name
+    size_t segmentSize;
+    uint64_t size;
+    std::vector<ndn::Block> segments;
+};
+
+/**
+ * @brief LRU cache of directory listings by path, shared by all threads. A
+ * listing is named by the directory version, so an entry is replaced as soon
+ * as a newer version is requested
+ *
+ */
+class ListingCache {
+  public:
+    ListingCache(size_t capacity = 0) : capacity_{capacity} {
+    }
+
+    /**
+     * @brief Get the listing of a directory, reading it when not cached
+     *
+     * @param path The directory path
+     * @param version The directory version
+     * @param segmentSize The segment size
+     * @return std::shared_ptr<const DirListing> The listing, or nullptr if
+     * the directory can not be read or its version is different
+     */
+    std::shared_ptr<const DirListing> get(const std::string &path,
+                                          uint64_t version,
+                                          size_t segmentSize) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (auto it = index_.find(path); it != index_.end()) {
+                auto &cached = it->second->second;
+                if (cached->version == version &&
+                    cached->segmentSize == segmentSize) {
+                    lru_.splice(lru_.begin(), lru_, it->second);
+                    return cached;
+                }
+            }
+        }
+
+        // Read outside the lock, directories may be huge
+        auto listing = read(path, version, segmentSize);
+        if (listing == nullptr || capacity_ == 0) {
+            return listing;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (auto it = index_.find(path); it != index_.end()) {
+            lru_.erase(it->second);
+            index_.erase(it);
+        }
+
+        if (lru_.size() >= capacity_) {
+            index_.erase(lru_.back().first);
+            lru_.pop_back();
+        }
+
+        lru_.emplace_front(path, listing);
+        index_[path] = lru_.begin();
+        return listing;
+    }
+
+  private:
+    struct LinuxDirent64 {
+        ino64_t d_ino;
+        off64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[];
+    };
+
+    static std::shared_ptr<DirListing>
+    read(const std::string &path, uint64_t version, size_t segmentSize) {
+        if (segmentSize == 0) {
+            return nullptr;
+        }
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        // The entries are at least as recent as the version
+        struct stat st;
+        if (::fstat(fd, &st) != 0 ||
+            static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                    st.st_mtim.tv_nsec !=
+                version) {
+            ::close(fd);
+            return nullptr;
+        }
+
+        std::string entries;
+        std::vector<char> buf(direntBatchSize);
+
+        long n;
+        while ((n = syscall(SYS_getdents64, fd, buf.data(), buf.size())) > 0) {
+            for (long pos = 0; pos < n;) {
+                auto d = reinterpret_cast<LinuxDirent64 *>(buf.data() + pos);
+                pos += d->d_reclen;
+
+                if (d->d_name[0] == '.' &&
+                    (d->d_name[1] == '\0' ||
+                     (d->d_name[1] == '.' && d->d_name[2] == '\0'))) {
+                    continue;
+                }
+
+                entries.append(d->d_name);
+                if (isDir(fd, d)) {
+                    entries.push_back('/');
+                }
+                entries.push_back('\0');
+            }
+        }
+
+        ::close(fd);
+        if (n < 0) {
+            return nullptr;
+        }
+
+        auto listing = std::make_shared<DirListing>();
+        listing->version = version;
+        listing->segmentSize = segmentSize;
+        listing->size = entries.size();
+
+        // An empty directory still has one, empty, segment
+        size_t offset = 0;
+        do {
+            auto len = std::min(segmentSize, entries.size() - offset);
+            auto buff = std::make_shared<ndn::Buffer>(
+                entries.data() + offset, entries.data() + offset + len);
+            listing->segments.emplace_back(ndn::tlv::Content, std::move(buff));
+            offset += len;
+        } while (offset < entries.size());
+
+        return listing;
+    }
+
+    // Symbolic links are listed as what they point to
+    static bool isDir(int dirfd, const LinuxDirent64 *d) {
+        if (d->d_type != DT_UNKNOWN && d->d_type != DT_LNK) {
+            return d->d_type == DT_DIR;
+        }
+
+        struct stat st;
+        return ::fstatat(dirfd, d->d_name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+    }
+
+  private:
+    // Bytes of directory entries read by each getdents64 call
+    static constexpr size_t direntBatchSize = 1 << 20;
+
+    using Entries =
+        std::list<std::pair<std::string, std::shared_ptr<const DirListing>>>;
+
+    size_t capacity_;
+    Entries lru_;
+    std::unordered_map<std::string, Entries::iterator> index_;
+    std::mutex mutex_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_LISTING_CACHE_HPP
@@ -0,0 +1,280 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_METADATA_CACHE_HPP
+#define NDNC_APP_FILE_TRANSFER_SERVER_FT_METADATA_CACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <poll.h>
+#include <string>
+#include <sys/inotify.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <ndn-cxx/encoding/block.hpp>
+
+#include "logger/logger.hpp"
+
+namespace ndnc::app::filetransfer {
+/**
+ * @brief LRU cache of encoded RDR metadata Content by path, shared by all
+ * threads. Every cached path is watched with inotify and its entry dropped
+ * as soon as the file, or the entries of the directory, change
+ *
+ */
+class MetadataCache {
+  public:
+    MetadataCache(size_t capacity = 0)
+        : capacity_{capacity}, inotifyFd_{-1}, events_{0}, stop_{false} {
+        if (capacity_ == 0) {
+            return;
+        }
+
+        inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd_ < 0) {
+            LOG_WARN("unable to init inotify, metadata cache disabled");
+            return;
+        }
+
+        watcher_ = std::thread(&MetadataCache::watch, this);
+    }
+
+    ~MetadataCache() {
+        stop_ = true;
+        if (watcher_.joinable()) {
+            watcher_.join();
+        }
+
+        if (inotifyFd_ >= 0) {
+            ::close(inotifyFd_);
+        }
+    }
+
+    /**
+     * @brief Get the encoded metadata of a path
+     *
+     * @param path The file or directory path
+     * @param content The metadata Content
+     * @return true The metadata is cached
+     * @return false The metadata is not cached
+     */
+    bool get(const std::string &path, ndn::Block &content) {
+        if (inotifyFd_ < 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = index_.find(path);
+        if (it == index_.end()) {
+            return false;
+        }
+
+        lru_.splice(lru_.begin(), lru_, it->second);
+        content = it->second->second.content;
+        return true;
+    }
+
+    struct Watch {
+        int wd;
+        // Number of inotify events seen when the watch was added
+        uint64_t events;
+    };
+
+    /**
+     * @brief Start watching a path, before reading its metadata, so that no
+     * change made while the metadata is encoded goes unnoticed
+     *
+     * @param path The file or directory path
+     * @param watch Passed on to insert()
+     * @return true The path is watched
+     * @return false The metadata of this path can not be cached
+     */
+    bool prepare(const std::string &path, Watch &watch) {
+        if (inotifyFd_ < 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // The same watch descriptor is returned for every name of an inode
+        int wd = inotify_add_watch(inotifyFd_, path.c_str(), watchMask);
+        if (wd < 0) {
+            return false;
+        }
+
+        watches_[wd].insert(path);
+        watch = Watch{wd, events_};
+        return true;
+    }
+
+    /**
+     * @brief Cache the encoded metadata of a path, unless any change was
+     * noticed since prepare()
+     *
+     * @param path The file or directory path
+     * @param content The metadata Content
+     * @param watch The watch added by prepare()
+     */
+    void insert(const std::string &path, const ndn::Block &content,
+                const Watch &watch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (auto it = index_.find(path); it != index_.end()) {
+            // Renamed over since; keep only the watch of the cached inode
+            if (it->second->second.wd != watch.wd) {
+                unwatch(watch.wd, path);
+            }
+            return;
+        }
+
+        // The watch may be gone already; never cache what it can not guard
+        if (watch.events != events_) {
+            unwatch(watch.wd, path);
+            return;
+        }
+
+        if (lru_.size() >= capacity_) {
+            auto &last = lru_.back();
+            unwatch(last.second.wd, last.first);
+            index_.erase(last.first);
+            lru_.pop_back();
+        }
+
+        lru_.emplace_front(path, Entry{content, watch.wd});
+        index_[path] = lru_.begin();
+    }
+
+    /**
+     * @brief Drop the watch added by prepare() when the metadata could not
+     * be read, e.g. the path is gone
+     *
+     * @param path The file or directory path
+     * @param watch The watch added by prepare()
+     */
+    void abandon(const std::string &path, const Watch &watch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Another request may have cached the path under the same watch
+        if (auto it = index_.find(path);
+            it != index_.end() && it->second->second.wd == watch.wd) {
+            return;
+        }
+
+        unwatch(watch.wd, path);
+    }
+
+  private:
+    struct Entry {
+        ndn::Block content;
+        int wd;
+    };
+
+    void watch() {
+        alignas(struct inotify_event) char buf[4096];
+        struct pollfd pfd = {inotifyFd_, POLLIN, 0};
+
+        while (!stop_) {
+            if (::poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+
+            ssize_t n;
+            while ((n = ::read(inotifyFd_, buf, sizeof(buf))) > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                for (char *p = buf; p < buf + n;) {
+                    auto event = reinterpret_cast<struct inotify_event *>(p);
+                    invalidate(event->wd);
+                    p += sizeof(struct inotify_event) + event->len;
+                }
+            }
+        }
+    }
+
+    // Every watch is one-shot, the kernel removes it with the first event
+    void invalidate(int wd) {
+        ++events_;
+
+        auto it = watches_.find(wd);
+        if (it == watches_.end()) {
+            return;
+        }
+
+        for (auto &path : it->second) {
+            if (auto entry = index_.find(path); entry != index_.end()) {
+                lru_.erase(entry->second);
+                index_.erase(entry);
+            }
+        }
+
+        watches_.erase(it);
+    }
+
+    void unwatch(int wd, const std::string &path) {
+        auto it = watches_.find(wd);
+        if (it == watches_.end()) {
+            return;
+        }
+
+        it->second.erase(path);
+        if (it->second.empty()) {
+            inotify_rm_watch(inotifyFd_, wd);
+            watches_.erase(it);
+        }
+    }
+
+  private:
+    // File content and attributes, and entries of directories
+    static constexpr uint32_t watchMask =
+        IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF |
+        IN_DELETE_SELF | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+        IN_ONESHOT;
+
+    using Entries = std::list<std::pair<std::string, Entry>>;
+
+    size_t capacity_;
+    Entries lru_;
+    std::unordered_map<std::string, Entries::iterator> index_;
+    // Paths by watch descriptor; more than one for hard links
+    std::unordered_map<int, std::unordered_set<std::string>> watches_;
+
+    int inotifyFd_;
+    // Number of inotify events seen, to discard metadata read concurrently
+    // with a change
+    uint64_t events_;
+    std::atomic_bool stop_;
+    std::thread watcher_;
+    std::mutex mutex_;
+};
+}; // namespace ndnc::app::filetransfer
+
+#endif // NDNC_APP_FILE_TRANSFER_SERVER_FT_METADATA_CACHE_HPP
@@ -25,51 +25,421 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+#include <fcntl.h>
+#include <iomanip>
+#include <limits.h>
 #include <math.h>
+#include <stdlib.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "ft-server.hpp"
 #include "logger/logger.hpp"
+#include "utils/adler32.hpp"
+#include "utils/crc32c.hpp"
+
+namespace {
+size_t sizeOfTlvHeader(uint32_t type, uint64_t length) {
+    return ndn::tlv::sizeOfVarNumber(type) + ndn::tlv::sizeOfVarNumber(length);
+}
+
+uint8_t *writeVarNumber(uint8_t *p, uint64_t n) {
+    auto size = ndn::tlv::sizeOfVarNumber(n);
+    if (size == 1) {
+        *p++ = static_cast<uint8_t>(n);
+        return p;
+    }
+
+    *p++ = size == 3 ? 253 : size == 5 ? 254 : 255;
+    for (auto i = static_cast<int>(size) - 2; i >= 0; --i) {
+        *p++ = static_cast<uint8_t>(n >> (8 * i));
+    }
+    return p;
+}
+
+uint8_t *writeTlvHeader(uint8_t *p, uint32_t type, uint64_t length) {
+    return writeVarNumber(writeVarNumber(p, type), length);
+}
+
+uint8_t *writeBytes(uint8_t *p, const uint8_t *bytes, size_t size) {
+    return std::copy_n(bytes, size, p);
+}
+}; // namespace
 
 namespace ndnc::app::filetransfer {
 Server::Server(face::Face &face, ServerOptions options)
-    : PacketHandler(face), options_{options}, signatureInfo_{} {
+    : PacketHandler(face), options_{options}, signatureInfo_{},
+      signatureTail_{}, spliced_{0},
+      fds_{options.fdCacheSize}, cache_{options.dataCacheSize},
+      metadata_{options.metadataCacheSize},
+      listings_{options.listingCacheSize}, checksums_{},
+      checksumQueue_{}, checksumPending_{}, checksumStop_{false}, workers_{},
+      workersStop_{false}, txQueue_{}, txBurst_{} {
+
+    signatureInfo_.setSignatureType(ndn::tlv::DigestSha256);
 
+    auto info = signatureInfo_.wireEncode(ndn::SignatureInfo::Type::Data);
+    auto value = ndn::makeEmptyBlock(ndn::tlv::SignatureValue);
+    signatureTail_.insert(signatureTail_.end(), info.begin(), info.end());
+    signatureTail_.insert(signatureTail_.end(), value.begin(), value.end());
+
+    // Synthetic content is served for any Name; leave room for the file path
     auto buff = std::make_unique<ndn::Buffer>();
-    buff->assign(options_.segmentSize, 'p');
+    buff->assign(getSegmentSize(options_.prefix.deepCopy().append(
+                     std::string(syntheticPathRoom, 'p'))),
+                 'p');
     payload_ = ndn::Block(ndn::tlv::Content, std::move(buff));
 
-    signatureInfo_.setSignatureType(ndn::tlv::DigestSha256);
+    if (options_.segmentSize == 0) {
+        LOG_INFO("segment size derived from dataroom=%zu", options_.mtu);
+    }
+
+    if (options_.splice && options_.workers > 0) {
+        LOG_WARN("splice is not available with workers, disabled");
+        options_.splice = false;
+    }
+
+    checksumWorker_ = std::thread(&Server::computeChecksums, this);
+
+    for (size_t i = 0; i < options_.workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>(options_.fdCacheSize,
+                                                    options_.dataCacheSize));
+    }
+    for (auto &worker : workers_) {
+        worker->thread = std::thread(&Server::runWorker, this, worker.get());
+    }
+
+    if (!workers_.empty()) {
+        LOG_INFO("serving Interests with %zu workers", workers_.size());
+    }
 }
 
 Server::~Server() {
+    workersStop_ = true;
+    for (auto &worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(checksumMutex_);
+        checksumStop_ = true;
+    }
+    checksumCv_.notify_all();
+
+    if (checksumWorker_.joinable()) {
+        checksumWorker_.join();
+    }
 }
 
 void Server::onInterest(std::shared_ptr<ndn::Interest> &&interest,
                         ndn::lp::PitToken &&pitToken) {
+    if (!workers_.empty()) {
+        // All work for one Name lands on the same worker
+        auto i = std::hash<ndn::Name>{}(interest->getName()) % workers_.size();
+        workers_[i]->queue.enqueue(
+            Request{std::move(interest), std::move(pitToken)});
+        return;
+    }
 
-    auto name = interest->getName();
-    auto data = ndnc::posix::isRDRDiscoveryName(name)
-                    ? getFileMetadata(name)
-                    : getFileContentData(name);
+    if (options_.splice && !options_.synthetic &&
+        spliceFileContent(interest->getName(), pitToken)) {
+        return;
+    }
 
-    data->setSignatureInfo(signatureInfo_);
-    data->setSignatureValue(std::make_shared<ndn::Buffer>());
+    ndn::Block wire;
+    if (!getDataWire(interest->getName(), fds_, cache_, wire)) {
+        // Not ready yet; the consumer retransmits the Interest on timeout
+        return;
+    }
 
-    if (face != nullptr &&
-        !face->send(getWireEncode(std::move(data), std::move(pitToken)))) {
-        LOG_WARN("unable to send Data packet");
+    // Sent with the rest of the RX burst on flush
+    txBurst_.push_back(getWireEncode(wire, std::move(pitToken)));
+    if (txBurst_.size() >= txBurstSize) {
+        sendBurst();
     }
 }
 
+void Server::flush() {
+    if (workers_.empty()) {
+        sendBurst();
+        if (spliced_ > 0 && face != nullptr) {
+            face->flush();
+        }
+        spliced_ = 0;
+        return;
+    }
+
+    while (true) {
+        txBurst_.resize(txBurstSize);
+        auto n = txQueue_.try_dequeue_bulk(txBurst_.begin(), txBurstSize);
+        txBurst_.resize(n);
+
+        if (n == 0) {
+            break;
+        }
+        sendBurst();
+    }
+}
+
+void Server::sendBurst() {
+    if (txBurst_.empty()) {
+        return;
+    }
+
+    if (face != nullptr && face->send(&txBurst_, txBurst_.size()) < 0) {
+        LOG_WARN("unable to send %zu Data packets", txBurst_.size());
+    }
+    txBurst_.clear();
+}
+
+void Server::runWorker(Worker *worker) {
+    std::vector<Request> requests(txBurstSize);
+    std::vector<ndn::Block> wires;
+    wires.reserve(txBurstSize);
+
+    while (!workersStop_) {
+        auto n = worker->queue.wait_dequeue_bulk_timed(
+            requests.begin(), requests.size(), std::chrono::milliseconds(10));
+
+        for (size_t i = 0; i < n; ++i) {
+            ndn::Block wire;
+            if (getDataWire(requests[i].interest->getName(), worker->fds,
+                            worker->cache, wire)) {
+                auto &token = requests[i].pitToken;
+                wires.push_back(getWireEncode(
+                    wire, ndn::lp::PitToken(
+                              std::make_pair(token.cbegin(), token.cend()))));
+            }
+            requests[i] = Request{};
+        }
+
+        if (!wires.empty()) {
+            txQueue_.enqueue_bulk(std::make_move_iterator(wires.begin()),
+                                  wires.size());
+            wires.clear();
+        }
+    }
+}
+
+bool Server::getDataWire(const ndn::Name &name, FdCache &fds,
+                         DataCache &cache, ndn::Block &wire) {
+    auto isContent = !ndnc::posix::isRDRDiscoveryName(name) &&
+                     !ndnc::posix::isRDRChecksumName(name);
+
+    if (isContent && cache.get(name, wire)) {
+        return true;
+    }
+
+    auto data = getData(name, fds);
+    if (data == nullptr) {
+        return false;
+    }
+
+    wire = data->wireEncode();
+
+    // Metadata and checksums follow the file; Nacks may turn into content
+    if (isContent && !options_.synthetic &&
+        data->getContentType() == ndn::tlv::ContentType_Blob) {
+        cache.insert(name, wire);
+    }
+
+    return true;
+}
+
+std::shared_ptr<ndn::Data> Server::getData(const ndn::Name &name,
+                                           FdCache &fds) {
+    auto data = ndnc::posix::isRDRDirListingName(name)
+                    ? getDirListingMetadata(name)
+                : ndnc::posix::isRDRDiscoveryName(name) ? getFileMetadata(name)
+                : ndnc::posix::isRDRChecksumName(name)
+                    ? getFileChecksum(name)
+                : ndnc::posix::isRDRDirListingContentName(name)
+                    ? getDirListingContent(name)
+                    : getFileContentData(name, fds);
+
+    if (data != nullptr) {
+        data->setSignatureInfo(signatureInfo_);
+        data->setSignatureValue(std::make_shared<ndn::Buffer>());
+    }
+
+    return data;
+}
+
+size_t Server::getSegmentSize(const ndn::Name &fileName) const {
+    if (options_.segmentSize > 0) {
+        return options_.segmentSize;
+    }
+
+    // Worst case of the parts that vary between the Data packets of a file:
+    // 8-octet version and segment numbers and a 32-octet PIT token
+    constexpr size_t componentMax = 2 + 8;
+    constexpr size_t pitTokenMax = 2 + 32;
+
+    auto dataroom = options_.mtu;
+    auto header = 1 + ndn::tlv::sizeOfVarNumber(dataroom);
+    auto nameValue = fileName.wireEncode().value_size() + 2 * componentMax;
+
+    // LpPacket, PitToken, Fragment, Data, Name, MetaInfo with FinalBlockId,
+    // Content, SignatureInfo and SignatureValue
+    auto overhead = header + pitTokenMax + header + header +
+                    sizeOfTlvHeader(ndn::tlv::Name, nameValue) + nameValue +
+                    2 + 2 + componentMax + header + signatureTail_.size();
+
+    return overhead < dataroom ? dataroom - overhead : 0;
+}
+
+bool Server::resolvePath(const std::string &path, std::string &real) const {
+    // Rejected by rdrPath
+    if (path.empty()) {
+        return false;
+    }
+
+    // Symlinks are followed, but never out of the root
+    char buf[PATH_MAX];
+    if (::realpath((options_.root + path).c_str(), buf) == nullptr) {
+        return false;
+    }
+
+    real = buf;
+    return options_.root == "/" || real == options_.root ||
+           real.compare(0, options_.root.size() + 1, options_.root + "/") == 0;
+}
+
+bool Server::spliceFileContent(const ndn::Name &name,
+                               const ndn::lp::PitToken &pitToken) {
+    // Anything unusual goes through getFileContentData, which answers Nacks
+    if (face == nullptr || ndnc::posix::isRDRDiscoveryName(name) ||
+        ndnc::posix::isRDRChecksumName(name) ||
+        ndnc::posix::isRDRDirListingContentName(name) ||
+        name.size() < options_.prefix.size() + 2 || !name.at(-1).isSegment() ||
+        !name.at(-2).isVersion()) {
+        return false;
+    }
+
+    std::string path;
+    if (!resolvePath(ndnc::posix::rdrFileContentUri(name, options_.prefix),
+                     path)) {
+        return false;
+    }
+
+    OpenFile file;
+    if (!fds_.get(path, file) || name.at(-2).toVersion() != file.mtime) {
+        return false;
+    }
+
+    auto segmentSize = getSegmentSize(name.getPrefix(-2));
+    if (segmentSize == 0) {
+        return false;
+    }
+
+    auto segment = name.at(-1).toSegment();
+    auto finalBlockId = file.size > 0 ? (file.size - 1) / segmentSize : 0;
+    auto offset = segment * segmentSize;
+
+    if (segment > finalBlockId) {
+        return false;
+    }
+
+    auto len = std::min<uint64_t>(segmentSize, file.size - offset);
+
+    // The same TLVs as getWireEncode(getFileContentData(name)), sized up
+    // front so that the content can be read in place
+    auto &nameWire = name.wireEncode();
+    ndn::MetaInfo metaInfo;
+    metaInfo.setFinalBlock(ndn::name::Component::fromSegment(finalBlockId));
+    auto &metaWire = metaInfo.wireEncode();
+
+    auto dataValueLen = nameWire.size() + metaWire.size() +
+                        sizeOfTlvHeader(ndn::tlv::Content, len) + len +
+                        signatureTail_.size();
+    auto dataLen = sizeOfTlvHeader(ndn::tlv::Data, dataValueLen) + dataValueLen;
+    auto lpValueLen =
+        sizeOfTlvHeader(ndn::lp::tlv::PitToken, pitToken.size()) +
+        pitToken.size() + sizeOfTlvHeader(ndn::lp::tlv::Fragment, dataLen) +
+        dataLen;
+    auto lpLen =
+        sizeOfTlvHeader(ndn::lp::tlv::LpPacket, lpValueLen) + lpValueLen;
+
+    auto buf = face->reserve(lpLen);
+    if (buf == nullptr) {
+        return false;
+    }
+
+    auto p = writeTlvHeader(buf, ndn::lp::tlv::LpPacket, lpValueLen);
+    p = writeTlvHeader(p, ndn::lp::tlv::PitToken, pitToken.size());
+    p = writeBytes(p, pitToken.data(), pitToken.size());
+    p = writeTlvHeader(p, ndn::lp::tlv::Fragment, dataLen);
+    p = writeTlvHeader(p, ndn::tlv::Data, dataValueLen);
+    p = writeBytes(p, nameWire.wire(), nameWire.size());
+    p = writeBytes(p, metaWire.wire(), metaWire.size());
+    p = writeTlvHeader(p, ndn::tlv::Content, len);
+
+    // Page cache to shared memory, the only copy of the content
+    auto n = pread(file.fd, p, len, offset);
+    if (n < 0 || static_cast<uint64_t>(n) != len) {
+        LOG_ERROR("unable to read file '%s' at offset=%lu", path.c_str(),
+                  offset);
+        fds_.erase(path);
+
+        // A Nack is never longer than the reserved content Data
+        auto nack = std::make_shared<ndn::Data>(name);
+        nack->setContentType(ndn::tlv::ContentType_Nack);
+        nack->setSignatureInfo(signatureInfo_);
+        nack->setSignatureValue(std::make_shared<ndn::Buffer>());
+        auto wire = getWireEncode(std::move(nack), ndn::lp::PitToken(pitToken));
+
+        writeBytes(buf, wire.wire(), std::min(wire.size(), lpLen));
+        face->commit(std::min(wire.size(), lpLen));
+    } else {
+        writeBytes(p + len, signatureTail_.data(), signatureTail_.size());
+        face->commit(lpLen);
+    }
+
+    if (++spliced_ >= txBurstSize) {
+        face->flush();
+        spliced_ = 0;
+    }
+
+    return true;
+}
+
 std::shared_ptr<ndn::Data> Server::getFileMetadata(const ndn::Name name) {
     LOG_INFO("received meta Interest %s", name.toUri().c_str());
 
     auto data = std::make_shared<ndn::Data>(name);
-    ndnc::posix::FileMetadata metadata{options_.segmentSize};
+    auto segmentSize = getSegmentSize(name.getPrefix(-1));
+    ndnc::posix::FileMetadata metadata{segmentSize};
+
+    auto uri = ndnc::posix::rdrFileUri(name, options_.prefix);
+    std::string path;
+    auto found = resolvePath(uri, path);
 
-    if (metadata.prepare(ndnc::posix::rdrFileUri(name, options_.prefix),
-                         name.getPrefix(-1))) {
-        data->setContent(metadata.encode());
+    // The metadata holds the requested Name; cache it by the path in the
+    // Name, not by the symlink target
+    auto key = options_.root + uri;
+
+    ndn::Block content;
+    if (found && !metadata_.get(key, content) && segmentSize > 0) {
+        // Watch first, a change during statx then discards the result
+        MetadataCache::Watch watch;
+        auto watched = metadata_.prepare(key, watch);
+
+        if (metadata.prepare(path, name.getPrefix(-1))) {
+            content = metadata.encode();
+            if (watched) {
+                metadata_.insert(key, content, watch);
+            }
+        } else if (watched) {
+            metadata_.abandon(key, watch);
+        }
+    }
+
+    if (content.isValid()) {
+        data->setContent(content);
         data->setContentType(ndn::tlv::ContentType_Blob);
     } else {
         data->setContent(ndn::span<uint8_t>{});
@@ -80,11 +450,270 @@ std::shared_ptr<ndn::Data> Server::getFileMetadata(const ndn::Name name) {
     return data;
 }
 
-std::shared_ptr<ndn::Data> Server::getFileContentData(const ndn::Name name) {
+std::shared_ptr<ndn::Data> Server::getFileContentData(const ndn::Name name,
+                                                      FdCache &fds) {
+    auto data = std::make_shared<ndn::Data>(name);
+
+    if (options_.synthetic) {
+        data->setContent(payload_);
+        data->setContentType(ndn::tlv::ContentType_Blob);
+        return data;
+    }
+
+    auto nack = [&data]() {
+        data->setContent(ndn::span<uint8_t>{});
+        data->setContentType(ndn::tlv::ContentType_Nack);
+        return data;
+    };
+
+    // <prefix>/<path>/<version>/<segment>
+    if (name.size() < options_.prefix.size() + 2 || !name.at(-1).isSegment() ||
+        !name.at(-2).isVersion()) {
+        LOG_WARN("unexpected content Interest %s", name.toUri().c_str());
+        return nack();
+    }
+
+    std::string path;
+    if (!resolvePath(ndnc::posix::rdrFileContentUri(name, options_.prefix),
+                     path)) {
+        return nack();
+    }
+
+    OpenFile file;
+    if (!fds.get(path, file)) {
+        return nack();
+    }
+
+    // The file changed since the metadata was served
+    if (name.at(-2).toVersion() != file.mtime) {
+        return nack();
+    }
+
+    auto segmentSize = getSegmentSize(name.getPrefix(-2));
+    if (segmentSize == 0) {
+        return nack();
+    }
+
+    auto segment = name.at(-1).toSegment();
+    auto finalBlockId = file.size > 0 ? (file.size - 1) / segmentSize : 0;
+    auto offset = segment * segmentSize;
+
+    if (segment > finalBlockId) {
+        return nack();
+    }
+
+    auto len = std::min<uint64_t>(segmentSize, file.size - offset);
+    auto buff = std::make_shared<ndn::Buffer>(len);
+
+    auto n = pread(file.fd, buff->data(), len, offset);
+    if (n < 0 || static_cast<uint64_t>(n) != len) {
+        LOG_ERROR("unable to read file '%s' at offset=%lu", path.c_str(),
+                  offset);
+        fds.erase(path);
+        return nack();
+    }
+
+    data->setContent(ndn::Block(ndn::tlv::Content, std::move(buff)));
+    data->setContentType(ndn::tlv::ContentType_Blob);
+    data->setFinalBlock(ndn::name::Component::fromSegment(finalBlockId));
+    return data;
+}
+
+std::shared_ptr<ndn::Data> Server::getFileChecksum(const ndn::Name name) {
+    LOG_INFO("received checksum Interest %s", name.toUri().c_str());
+
+    std::string path;
+    auto found = resolvePath(
+        ndnc::posix::rdrChecksumFileUri(name, options_.prefix), path);
+    auto algorithm = name.at(-1).toUri();
+
+    auto data = std::make_shared<ndn::Data>(name);
+    data->setFreshnessPeriod(ndn::time::milliseconds{2});
+
+    auto nack = [&data]() {
+        data->setContent(ndn::span<uint8_t>{});
+        data->setContentType(ndn::tlv::ContentType_Nack);
+        return data;
+    };
+
+    if (algorithm != "adler32" && algorithm != "crc32c") {
+        LOG_WARN("unsupported checksum algorithm=%s", algorithm.c_str());
+        return nack();
+    }
+
+    struct stat st;
+    if (!found || ::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return nack();
+    }
+
+    uint32_t value = 0;
+    {
+        std::lock_guard<std::mutex> lock(checksumMutex_);
+
+        auto mtime = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                     st.st_mtim.tv_nsec;
+
+        auto it = checksums_.find(path);
+        if (it == checksums_.end() || it->second.mtime != mtime ||
+            it->second.size != static_cast<uint64_t>(st.st_size)) {
+            // Large files take a while; compute off the packet loop
+            if (checksumPending_.insert(path).second) {
+                checksumQueue_.push_back(path);
+                checksumCv_.notify_one();
+            }
+
+            // Answer right away so that the consumer polls instead of
+            // timing out; about 1 GB/s of checksum throughput
+            auto retryAfter = std::clamp<uint64_t>(
+                static_cast<uint64_t>(st.st_size) / 1000000, 100, 5000);
+            LOG_DEBUG("checksum of '%s' pending, retry after %lu ms",
+                      path.c_str(), retryAfter);
+
+            data->setFreshnessPeriod(ndn::time::milliseconds{0});
+            data->setContent(ndn::encoding::makeNonNegativeIntegerBlock(
+                ndn::tlv::Content, retryAfter));
+            data->setContentType(ndnc::posix::checksumPendingContentType);
+            return data;
+        }
+
+        value = algorithm == "adler32" ? it->second.adler32
+                                       : it->second.crc32c;
+    }
+
+    std::ostringstream hex;
+    hex << std::hex << std::setfill('0') << std::setw(8) << value;
+    auto str = hex.str();
+
+    data->setContent(ndn::span<const uint8_t>(
+        reinterpret_cast<const uint8_t *>(str.data()), str.size()));
+    data->setContentType(ndn::tlv::ContentType_Blob);
+    return data;
+}
+
+std::shared_ptr<ndn::Data>
+Server::getDirListingMetadata(const ndn::Name name) {
+    LOG_INFO("received ls Interest %s", name.toUri().c_str());
+
+    std::string path;
+    auto found =
+        resolvePath(ndnc::posix::rdrDirUri(name, options_.prefix), path);
+    auto segmentSize = getSegmentSize(name.getPrefix(-1));
+    ndnc::posix::FileMetadata metadata{segmentSize};
+
+    auto data = std::make_shared<ndn::Data>(name);
+    data->setFreshnessPeriod(ndn::time::milliseconds{2});
+
+    // The listing is named by the directory modification time
+    std::shared_ptr<const DirListing> listing;
+    if (found && segmentSize > 0 &&
+        metadata.prepare(path, name.getPrefix(-1)) &&
+        metadata.isDir()) {
+        listing = listings_.get(
+            path, metadata.getVersionedName().at(-1).toVersion(), segmentSize);
+    }
+
+    if (listing == nullptr) {
+        data->setContent(ndn::span<uint8_t>{});
+        data->setContentType(ndn::tlv::ContentType_Nack);
+        return data;
+    }
+
+    metadata.setContentSize(listing->size);
+    data->setContent(metadata.encode());
+    data->setContentType(ndn::tlv::ContentType_Blob);
+    return data;
+}
+
+std::shared_ptr<ndn::Data>
+Server::getDirListingContent(const ndn::Name name) {
+    auto segment = name.at(-1).toSegment();
+
     auto data = std::make_shared<ndn::Data>(name);
 
-    data->setContent(payload_);
+    // Only the version given by the metadata is served; the directory may
+    // have changed since
+    std::string path;
+    std::shared_ptr<const DirListing> listing;
+    if (resolvePath(ndnc::posix::rdrDirListingUri(name, options_.prefix),
+                    path)) {
+        listing = listings_.get(path, name.at(-2).toVersion(),
+                                getSegmentSize(name.getPrefix(-2)));
+    }
+    if (listing == nullptr || segment >= listing->segments.size()) {
+        data->setContent(ndn::span<uint8_t>{});
+        data->setContentType(ndn::tlv::ContentType_Nack);
+        return data;
+    }
+
+    data->setContent(listing->segments[segment]);
     data->setContentType(ndn::tlv::ContentType_Blob);
+    data->setFinalBlock(
+        ndn::name::Component::fromSegment(listing->segments.size() - 1));
     return data;
 }
+
+void Server::computeChecksums() {
+    while (true) {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(checksumMutex_);
+            checksumCv_.wait(lock, [this] {
+                return checksumStop_ || !checksumQueue_.empty();
+            });
+
+            if (checksumStop_) {
+                return;
+            }
+
+            path = std::move(checksumQueue_.front());
+            checksumQueue_.pop_front();
+        }
+
+        FileChecksum checksum{};
+        auto ok = computeChecksum(path, checksum);
+
+        std::lock_guard<std::mutex> lock(checksumMutex_);
+        checksumPending_.erase(path);
+        if (ok) {
+            checksums_[path] = checksum;
+        }
+    }
+}
+
+bool Server::computeChecksum(const std::string &path, FileChecksum &checksum) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("unable to open file '%s' for checksum", path.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    checksum.mtime = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                     st.st_mtim.tv_nsec;
+    checksum.size = st.st_size;
+    checksum.adler32 = 1;
+    checksum.crc32c = 0;
+
+    // Both checksums in a single pass over the file
+    std::vector<uint8_t> buf(1 << 20);
+    ssize_t n;
+    while ((n = ::read(fd, buf.data(), buf.size())) > 0) {
+        checksum.adler32 = ndnc::adler32(checksum.adler32, buf.data(), n);
+        checksum.crc32c = ndnc::crc32c(checksum.crc32c, buf.data(), n);
+    }
+
+    ::close(fd);
+
+    if (n < 0) {
+        LOG_ERROR("unable to read file '%s' for checksum", path.c_str());
+        return false;
+    }
+
+    return true;
+}
 }; // namespace ndnc::app::filetransfer
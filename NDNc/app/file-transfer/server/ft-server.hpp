@@ -28,7 +28,21 @@
 #ifndef NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_HPP
 #define NDNC_APP_FILE_TRANSFER_SERVER_FT_SERVER_HPP
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "../common/ft-naming-scheme.hpp"
+#include "congestion-control/concurrentqueue/blockingconcurrentqueue.h"
+#include "congestion-control/concurrentqueue/concurrentqueue.h"
+#include "ft-data-cache.hpp"
+#include "ft-fd-cache.hpp"
+#include "ft-listing-cache.hpp"
+#include "ft-metadata-cache.hpp"
 #include "face/packet-handler.hpp"
 #include "lib/posix/file-metadata.hpp"
 #include "lib/posix/file-rdr.hpp"
@@ -41,9 +55,34 @@ struct ServerOptions {
     size_t mtu = 9000;
     // Name prefix
     ndn::Name prefix = ndn::Name(NDNC_NAME_PREFIX_DEFAULT);
+    // Directory the Name paths are served from, with symlinks resolved.
+    // Nothing outside of it is served
+    std::string root = "/";
+
+    // Segment size. 0 fills the dataroom: the largest content that fits once
+    // the Name and all other TLVs of the file's Data packets are encoded
+    size_t segmentSize = 0;
 
-    // Segment size
-    size_t segmentSize = 6600;
+    // Serve the same synthetic payload for every segment instead of the file
+    // content, to benchmark the network path alone
+    bool synthetic = false;
+    // Maximum number of open file descriptors kept by the server
+    size_t fdCacheSize = 256;
+    // Maximum number of encoded content Data packets kept to answer repeated
+    // Interests without reading and encoding again. 0 disables the cache
+    size_t dataCacheSize = 4096;
+    // Maximum number of paths whose encoded metadata is kept, invalidated by
+    // inotify when the file changes. 0 runs statx for every metadata Interest
+    size_t metadataCacheSize = 4096;
+    // Maximum number of directory listings kept, each for the latest
+    // requested directory version. 0 reads the directory for every segment
+    size_t listingCacheSize = 256;
+    // Encode content Data in place in the memif TX buffers and read the file
+    // straight into them. Inline mode only, the face is not thread-safe
+    bool splice = false;
+    // Number of worker threads doing file I/O and encoding. Interests are
+    // sharded by Name hash; 0 serves them inline on the face loop thread
+    size_t workers = 0;
 };
 }; // namespace ndnc::app::filetransfer
 
@@ -57,14 +96,92 @@ class Server : public PacketHandler {
     void onInterest(std::shared_ptr<ndn::Interest> &&interest,
                     ndn::lp::PitToken &&pitToken) final;
 
+    /**
+     * @brief Send the Data packets produced since the last call, at the end
+     * of each RX burst. Must be called from the thread running the face loop
+     *
+     */
+    void flush();
+
   private:
+    struct Request {
+        std::shared_ptr<ndn::Interest> interest;
+        std::vector<uint8_t> pitToken;
+    };
+
+    struct Worker {
+        Worker(size_t fdCacheSize, size_t dataCacheSize)
+            : fds{fdCacheSize}, cache{dataCacheSize} {
+        }
+
+        moodycamel::BlockingConcurrentQueue<Request> queue;
+        // Each worker keeps its own descriptors and Data, the caches are not
+        // thread-safe. Sharding by Name hash keeps repeats on one worker
+        FdCache fds;
+        DataCache cache;
+        std::thread thread;
+    };
+
+    struct FileChecksum {
+        uint64_t mtime; // nanoseconds since Unix epoch, as in the Name version
+        uint64_t size;
+        uint32_t adler32;
+        uint32_t crc32c;
+    };
+
+  private:
+    bool getDataWire(const ndn::Name &name, FdCache &fds, DataCache &cache,
+                     ndn::Block &wire);
+    std::shared_ptr<ndn::Data> getData(const ndn::Name &name, FdCache &fds);
+    size_t getSegmentSize(const ndn::Name &fileName) const;
+    bool resolvePath(const std::string &path, std::string &real) const;
+    bool spliceFileContent(const ndn::Name &name,
+                           const ndn::lp::PitToken &pitToken);
     std::shared_ptr<ndn::Data> getFileMetadata(const ndn::Name name);
-    std::shared_ptr<ndn::Data> getFileContentData(const ndn::Name name);
+    std::shared_ptr<ndn::Data> getFileContentData(const ndn::Name name,
+                                                  FdCache &fds);
+    std::shared_ptr<ndn::Data> getFileChecksum(const ndn::Name name);
+    std::shared_ptr<ndn::Data> getDirListingMetadata(const ndn::Name name);
+    std::shared_ptr<ndn::Data> getDirListingContent(const ndn::Name name);
+
+    void runWorker(Worker *worker);
+    void sendBurst();
+
+    void computeChecksums();
+    bool computeChecksum(const std::string &path, FileChecksum &checksum);
 
   private:
     ServerOptions options_;
     ndn::Block payload_;
     ndn::SignatureInfo signatureInfo_;
+    // SignatureInfo and SignatureValue, the wire after the Data Content
+    ndn::Buffer signatureTail_;
+    size_t spliced_;
+    FdCache fds_;
+    DataCache cache_;
+    MetadataCache metadata_;
+    ListingCache listings_;
+
+    // File checksums by path, computed in the background and valid while the
+    // file size and modification time are unchanged
+    std::unordered_map<std::string, FileChecksum> checksums_;
+    std::deque<std::string> checksumQueue_;
+    std::unordered_set<std::string> checksumPending_;
+    std::mutex checksumMutex_;
+    std::condition_variable checksumCv_;
+    bool checksumStop_;
+    std::thread checksumWorker_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic_bool workersStop_;
+    // Encoded Data from all workers, sent by the face loop thread only as
+    // the memif transport is not thread-safe
+    moodycamel::ConcurrentQueue<ndn::Block> txQueue_;
+    // Data waiting to be sent with one memif TX burst
+    std::vector<ndn::Block> txBurst_;
+
+    static constexpr size_t txBurstSize = 64;
+    static constexpr size_t syntheticPathRoom = 256;
 };
 }; // namespace ndnc::app::filetransfer
 
@@ -27,7 +27,10 @@
 
 #include <fstream>
 #include <iostream>
+#include <limits.h>
 #include <signal.h>
+#include <stdlib.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <boost/program_options/options_description.hpp>
@@ -71,20 +74,65 @@ int main(int argc, char **argv) {
         "name-prefix", po::value<string>(&prefix)->default_value(prefix),
         "The NDN Name prefix this producer application advertises. Specify a "
         "non-empty string");
+    description.add_options()(
+        "root", po::value<string>(&opts.root)->required(),
+        "The directory served under the Name prefix. Paths that resolve "
+        "outside of it, e.g. through symlinks, are not served");
     description.add_options()(
         "segment-size",
         po::value<size_t>(&opts.segmentSize)->default_value(opts.segmentSize),
-        string("The maximum segment size of each Data packet that has "
-               "content from a file. Specify a positive integer smaller or "
-               "equal to " +
-               to_string(ndn::MAX_NDN_PACKET_SIZE))
-            .c_str());
+        "The maximum segment size of each Data packet that has content from a "
+        "file. Specify a positive integer smaller than the dataroom size, or "
+        "0 to fill the dataroom after the exact Data and NDNLPv2 overhead");
+    description.add_options()(
+        "synthetic",
+        po::bool_switch(&opts.synthetic)->default_value(opts.synthetic),
+        "Serve a synthetic payload instead of the file content, to benchmark "
+        "the network path alone");
+    description.add_options()(
+        "fd-cache",
+        po::value<size_t>(&opts.fdCacheSize)->default_value(opts.fdCacheSize),
+        "The maximum number of open file descriptors kept by the server");
+    description.add_options()(
+        "data-cache",
+        po::value<size_t>(&opts.dataCacheSize)
+            ->default_value(opts.dataCacheSize),
+        "The maximum number of encoded Data packets kept by the server, per "
+        "worker. Specify 0 to encode every Data packet");
+    description.add_options()(
+        "metadata-cache",
+        po::value<size_t>(&opts.metadataCacheSize)
+            ->default_value(opts.metadataCacheSize),
+        "The maximum number of paths whose encoded metadata is kept by the "
+        "server and invalidated by inotify. Specify 0 to stat the file for "
+        "every metadata Interest");
+    description.add_options()(
+        "listing-cache",
+        po::value<size_t>(&opts.listingCacheSize)
+            ->default_value(opts.listingCacheSize),
+        "The maximum number of directory listings kept by the server. "
+        "Specify 0 to read the directory for every listing segment");
+    description.add_options()(
+        "splice", po::bool_switch(&opts.splice)->default_value(opts.splice),
+        "Read file content straight into the memif TX buffers, with a single "
+        "copy from the page cache. Not available with workers");
+    description.add_options()(
+        "workers",
+        po::value<size_t>(&opts.workers)->default_value(opts.workers),
+        "The number of worker threads reading and encoding Data. Specify 0 to "
+        "serve Interests on the face thread");
     description.add_options()("help,h", "Print this help message and exit");
 
     po::variables_map vm;
     try {
         po::store(
             po::command_line_parser(argc, argv).options(description).run(), vm);
+
+        if (vm.count("help") > 0) {
+            usage(cout, description);
+            return 0;
+        }
+
         po::notify(vm);
     } catch (const po::error &e) {
         cerr << "ERROR: " << e.what() << "\n";
@@ -94,11 +142,6 @@ int main(int argc, char **argv) {
         return 2;
     }
 
-    if (vm.count("help") > 0) {
-        usage(cout, description);
-        return 0;
-    }
-
     if (vm.count("mtu") > 0) {
         if (opts.mtu < 64 || opts.mtu > 9000) {
             cerr << "ERROR: invalid MTU size\n\n";
@@ -116,7 +159,8 @@ int main(int argc, char **argv) {
     }
 
     if (vm.count("segment-size") > 0) {
-        if (opts.segmentSize > ndn::MAX_NDN_PACKET_SIZE) {
+        if (opts.segmentSize > ndn::MAX_NDN_PACKET_SIZE ||
+            opts.segmentSize >= opts.mtu) {
             cerr << "ERROR: invalid segment size value\n\n";
             usage(cout, description);
             return 2;
@@ -131,6 +175,18 @@ int main(int argc, char **argv) {
         }
     }
 
+    {
+        char root[PATH_MAX];
+        struct stat st;
+        if (::realpath(opts.root.c_str(), root) == nullptr ||
+            ::stat(root, &st) != 0 || !S_ISDIR(st.st_mode)) {
+            cerr << "ERROR: invalid root directory\n\n";
+            usage(cout, description);
+            return 2;
+        }
+        opts.root = root;
+    }
+
     opts.prefix = ndn::Name(prefix);
 
     face = new ndnc::face::Face();
@@ -149,6 +205,7 @@ int main(int argc, char **argv) {
 
     while (shouldRun && face->isConnected()) {
         face->loop();
+        server->flush();
     }
 
     cout << endl;
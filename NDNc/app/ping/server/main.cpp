@@ -141,6 +141,7 @@ int main(int argc, char **argv) {
 
     while (shouldRun && face->isConnected()) {
         face->loop();
+        server->flush();
     }
 
     cout << "\n--- statistics --\n"
@@ -36,7 +36,8 @@
 namespace ndnc {
 namespace ping {
 Server::Server(face::Face &face, ServerOptions options)
-    : PacketHandler(face), m_options{options}, m_counters{}, m_signatureInfo{} {
+    : PacketHandler(face), m_options{options}, m_counters{}, m_signatureInfo{},
+      m_txBurst{} {
 
     auto buff = std::make_unique<ndn::Buffer>();
     buff->assign(m_options.payloadLength, 'p');
@@ -62,13 +63,25 @@ void Server::onInterest(std::shared_ptr<ndn::Interest> &&interest,
     data->setSignatureValue(std::make_shared<ndn::Buffer>());
     data->setFreshnessPeriod(ndn::time::seconds{2});
 
-    if (face != nullptr &&
-        !face->send(getWireEncode(std::move(data), std::move(pitToken)))) {
-        LOG_WARN("unable to send Data packet on face");
+    m_txBurst.push_back(getWireEncode(std::move(data), std::move(pitToken)));
+    if (m_txBurst.size() >= m_txBurstSize) {
+        flush();
+    }
+}
+
+void Server::flush() {
+    if (m_txBurst.empty()) {
         return;
     }
 
-    ++m_counters.nTxData;
+    auto n = face != nullptr ? face->send(&m_txBurst, m_txBurst.size()) : -1;
+    if (n < 0) {
+        LOG_WARN("unable to send %zu Data packets on face", m_txBurst.size());
+    } else {
+        m_counters.nTxData += n;
+    }
+
+    m_txBurst.clear();
 }
 
 Server::Counters Server::getCounters() {
@@ -53,6 +53,13 @@ class Server : public PacketHandler,
 
     Counters getCounters();
 
+    /**
+     * @brief Send the Data packets produced since the last call with one TX
+     * burst. Called after each face loop, at the end of each RX burst
+     *
+     */
+    void flush();
+
   private:
     void onInterest(std::shared_ptr<ndn::Interest> &&interest,
                     ndn::lp::PitToken &&pitToken) final;
@@ -63,6 +70,9 @@ class Server : public PacketHandler,
 
     ndn::Block m_payload;
     ndn::SignatureInfo m_signatureInfo;
+
+    std::vector<ndn::Block> m_txBurst;
+    static constexpr size_t m_txBurstSize = 64;
 };
 }; // namespace ping
 }; // namespace ndnc
@@ -66,6 +66,15 @@ inline ndn::Block getWireEncode(std::shared_ptr<ndn::Data> &&data,
 
     return lpPacket.wireEncode();
 }
+
+inline ndn::Block getWireEncode(const ndn::Block &data,
+                                ndn::lp::PitToken &&pitToken) {
+    // A bare Data wire becomes the LP fragment
+    ndn::lp::Packet lpPacket(data);
+    lpPacket.add<ndn::lp::PitTokenField>(pitToken);
+
+    return lpPacket.wireEncode();
+}
 } // namespace ndnc
 
 namespace ndnc {
@@ -34,8 +34,10 @@
 
 namespace ndnc {
 class PendingInterest;
+class SegmentRange;
 
 typedef moodycamel::ConcurrentQueue<PendingInterest> RequestQueue;
+typedef moodycamel::ConcurrentQueue<SegmentRange> SegmentRangeQueue;
 typedef moodycamel::BlockingConcurrentQueue<std::shared_ptr<ndn::Data>>
     ResponseQueue;
 }; // namespace ndnc
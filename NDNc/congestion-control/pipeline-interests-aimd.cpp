@@ -53,6 +53,11 @@ void PipelineInterestsAimd::open() {
 
     while (!isClosed()) {
         face->loop();
+
+        if (isDisconnected() && !reconnect()) {
+            return;
+        }
+
         onTimeout();
 
         if (m_pit->size() >= m_windowSize) {
@@ -73,6 +78,12 @@ void PipelineInterestsAimd::open() {
 
         auto n = face->send(&pkts, size);
         if (n < 0) {
+            if (!face->isConnected()) {
+                // Send again once the face is re-created
+                face->disconnect();
+                continue;
+            }
+
             LOG_FATAL("unable to send Interest packets on face");
 
             close();
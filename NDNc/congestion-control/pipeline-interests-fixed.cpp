@@ -52,6 +52,11 @@ void PipelineInterestsFixed::open() {
 
     while (!isClosed()) {
         face->loop();
+
+        if (isDisconnected() && !reconnect()) {
+            return;
+        }
+
         onTimeout();
 
         if (m_pit->size() >= m_windowSize) {
@@ -72,6 +77,12 @@ void PipelineInterestsFixed::open() {
 
         auto n = face->send(&pkts, size);
         if (n < 0) {
+            if (!face->isConnected()) {
+                // Send again once the face is re-created
+                face->disconnect();
+                continue;
+            }
+
             LOG_FATAL("unable to send Interest packets on face");
             close();
             return;
@@ -28,7 +28,9 @@
 #ifndef NDNC_CONGESTION_CONTROL_PIPELINE_INTERESTS_HPP
 #define NDNC_CONGESTION_CONTROL_PIPELINE_INTERESTS_HPP
 
+#include <deque>
 #include <queue>
+#include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -36,6 +38,7 @@
 #include "face/packet-handler.hpp"
 #include "pending-interest.hpp"
 #include "pipeline-type.hpp"
+#include "segment-range.hpp"
 #include "utils/random-number-generator.hpp"
 
 namespace ndnc {
@@ -56,13 +59,17 @@ class PipelineInterests : public PacketHandler {
   private:
     using PendingInterestsOrder = std::queue<uint64_t>;
     using PendingInterestsTable = std::unordered_map<uint64_t, PendingInterest>;
-    using ResponseQueues = std::unordered_map<uint64_t, ResponseQueue>;
+    using ResponseQueues =
+        std::unordered_map<uint64_t, std::shared_ptr<ResponseQueue>>;
 
   public:
     explicit PipelineInterests(face::Face &face)
-        : PacketHandler(face), m_counters{}, m_closed{false} {
+        : PacketHandler(face), m_counters{}, m_closed{false},
+          m_disconnected{false} {
 
-        face.addOnDisconnectHandler([&]() { this->m_closed = true; });
+        // The face is re-created by the worker thread, outside of the
+        // transport callback
+        face.addOnDisconnectHandler([&]() { this->m_disconnected = true; });
 
         m_pit = std::make_shared<PendingInterestsTable>();
         m_piq = std::make_shared<PendingInterestsOrder>();
@@ -80,6 +87,7 @@ class PipelineInterests : public PacketHandler {
         }
 
         m_pit->clear();
+        m_ranges.clear();
 
         while (!m_piq->empty()) {
             m_piq->pop();
@@ -96,6 +104,10 @@ class PipelineInterests : public PacketHandler {
         return m_closed;
     }
 
+    bool isDisconnected() {
+        return m_disconnected;
+    }
+
     PipelineCounters getCounters() {
         return m_counters;
     }
@@ -109,11 +121,13 @@ class PipelineInterests : public PacketHandler {
     }
 
     uint64_t registerConsumer(const uint64_t consumerId) {
-        m_responseQueues[consumerId] = ResponseQueue();
+        std::unique_lock<std::shared_mutex> lock(m_responseQueuesMtx);
+        m_responseQueues[consumerId] = std::make_shared<ResponseQueue>();
         return consumerId;
     }
 
     void unregisterConsumer(const uint64_t consumerId) {
+        std::unique_lock<std::shared_mutex> lock(m_responseQueuesMtx);
         m_responseQueues.erase(consumerId);
     }
 
@@ -125,7 +139,7 @@ class PipelineInterests : public PacketHandler {
         }
 
         // Do nothing for requests from unregistered consumer ids
-        if (m_responseQueues.find(consumerId) == m_responseQueues.end()) {
+        if (getResponseQueue(consumerId) == nullptr) {
             LOG_ERROR("unable to push interest pkt. reason: unregistered "
                       "consumer id=%ld",
                       consumerId);
@@ -147,7 +161,7 @@ class PipelineInterests : public PacketHandler {
         }
 
         // Do nothing for requests from unregistered consumer ids
-        if (m_responseQueues.find(consumerId) == m_responseQueues.end()) {
+        if (getResponseQueue(consumerId) == nullptr) {
             LOG_ERROR("unable to push interest pkts. reason: unregistered "
                       "consumer id=%ld",
                       consumerId);
@@ -168,26 +182,89 @@ class PipelineInterests : public PacketHandler {
                                            newPendingInterests.size());
     }
 
+    /**
+     * @brief Request segments [first, last] of a versioned Name. The Interest
+     * packets are generated by the pipeline worker only when the window has
+     * room for them. Data packets are delivered to the consumer response queue
+     * in arrival order; the segment number indicates the position in range
+     *
+     * @param consumerId The registered consumer id
+     * @param name The versioned Name
+     * @param first The first segment number
+     * @param last The last segment number (inclusive)
+     * @param interestLifetime The lifetime of each generated Interest
+     * @return true The range was enqueued
+     * @return false The range was not enqueued
+     */
+    bool pushSegmentRange(uint64_t consumerId, const ndn::Name &name,
+                          uint64_t first, uint64_t last,
+                          ndn::time::milliseconds interestLifetime) {
+        // Do nothing if the pipeline is already closed
+        if (isClosed()) {
+            return false;
+        }
+
+        // Do nothing for requests from unregistered consumer ids
+        if (getResponseQueue(consumerId) == nullptr) {
+            LOG_ERROR("unable to push segment range. reason: unregistered "
+                      "consumer id=%ld",
+                      consumerId);
+            close();
+            return false;
+        }
+
+        if (first > last) {
+            LOG_ERROR("unable to push segment range. reason: invalid range "
+                      "[%ld, %ld]",
+                      first, last);
+            return false;
+        }
+
+        return m_rangeQueue.enqueue(
+            SegmentRange(name, first, last, interestLifetime, consumerId));
+    }
+
     bool popData(uint64_t consumerId, std::shared_ptr<ndn::Data> &pkt) {
-        try {
-            return m_responseQueues.at(consumerId).wait_dequeue_timed(pkt, 1e4);
-        } catch (const std::out_of_range &oor) {
-            LOG_ERROR("out of range error (pop data): %s", oor.what());
+        // The wait happens without the lock, the queue is kept alive by the
+        // shared_ptr even if the consumer is unregistered meanwhile
+        auto queue = getResponseQueue(consumerId);
+        if (queue == nullptr) {
+            LOG_ERROR("unable to pop data. reason: unregistered consumer "
+                      "id=%ld",
+                      consumerId);
             close();
             return false;
         }
+
+        return queue->wait_dequeue_timed(pkt, 1e4);
     }
 
     size_t popDataBulk(uint64_t consumerId,
                        std::vector<std::shared_ptr<ndn::Data>> &pkts) {
-        try {
-            return m_responseQueues.at(consumerId)
-                .wait_dequeue_bulk_timed(pkts.begin(), pkts.size(), 1e4);
-        } catch (const std::out_of_range &oor) {
-            LOG_ERROR("out of range error (pop many data): %s", oor.what());
+        auto queue = getResponseQueue(consumerId);
+        if (queue == nullptr) {
+            LOG_ERROR("unable to pop many data. reason: unregistered consumer "
+                      "id=%ld",
+                      consumerId);
             close();
             return 0;
         }
+
+        return queue->wait_dequeue_bulk_timed(pkts.begin(), pkts.size(), 1e4);
+    }
+
+    /**
+     * @brief Wake a consumer blocked in popData or popDataBulk, e.g. to let
+     * it submit new requests. It receives a Data packet with an empty Name
+     *
+     * @param consumerId The registered consumer id
+     * @return true The consumer was woken
+     * @return false The consumer is not registered
+     */
+    bool wakeConsumer(uint64_t consumerId) {
+        auto queue = getResponseQueue(consumerId);
+        return queue != nullptr &&
+               queue->enqueue(std::make_shared<ndn::Data>());
     }
 
   protected:
@@ -197,13 +274,16 @@ class PipelineInterests : public PacketHandler {
             return false;
         }
 
-        try {
-            return m_responseQueues.at(consumerId).enqueue(std::move(pkt));
-        } catch (const std::out_of_range &oor) {
-            LOG_ERROR("out of range error (push data): %s", oor.what());
-            close();
-            return false;
+        auto queue = getResponseQueue(consumerId);
+        if (queue == nullptr) {
+            // The consumer was unregistered while some of its Interests were
+            // still pending, e.g. a file closed with read-ahead in flight
+            LOG_DEBUG("Data for unregistered consumer id=%ld dropped",
+                      consumerId);
+            return true;
         }
+
+        return queue->enqueue(std::move(pkt));
     }
 
     size_t popPendingInterests(std::vector<PendingInterest> &pendingInterests,
@@ -213,9 +293,16 @@ class PipelineInterests : public PacketHandler {
         }
 
         pendingInterests.clear();
-        pendingInterests.reserve(n);
+        pendingInterests.resize(n);
 
-        return m_requestQueue.try_dequeue_bulk(pendingInterests.begin(), n);
+        // Retransmissions and explicit Interests take precedence over the
+        // segment ranges
+        auto size =
+            m_requestQueue.try_dequeue_bulk(pendingInterests.begin(), n);
+        size += generatePendingInterests(pendingInterests, size, n);
+
+        pendingInterests.resize(size);
+        return size;
     }
 
     bool refreshPITEntry(uint64_t key, bool timeoutReason = false) {
@@ -239,6 +326,108 @@ class PipelineInterests : public PacketHandler {
         return true;
     }
 
+  private:
+    /**
+     * @brief Get the response queue of a consumer. Consumers register and
+     * unregister from application threads while the worker looks them up
+     *
+     * @param consumerId The consumer id
+     * @return std::shared_ptr<ResponseQueue> The queue, nullptr if the
+     * consumer is not registered
+     */
+    std::shared_ptr<ResponseQueue> getResponseQueue(uint64_t consumerId) {
+        std::shared_lock<std::shared_mutex> lock(m_responseQueuesMtx);
+
+        auto it = m_responseQueues.find(consumerId);
+        return it != m_responseQueues.end() ? it->second : nullptr;
+    }
+
+    /**
+     * @brief Fill pendingInterests[index, n) with Interests generated from the
+     * active segment ranges. Ranges are served round-robin, one batch at a
+     * time, so that concurrent transfers share the window
+     *
+     */
+    size_t
+    generatePendingInterests(std::vector<PendingInterest> &pendingInterests,
+                             size_t index, size_t n) {
+        SegmentRange range;
+        while (m_rangeQueue.try_dequeue(range)) {
+            m_ranges.emplace_back(std::move(range));
+        }
+
+        size_t count = 0;
+        while (index + count < n && !m_ranges.empty()) {
+            auto &front = m_ranges.front();
+
+            // Drop the ranges of consumers that are no longer registered
+            if (getResponseQueue(front.getConsumerId()) == nullptr) {
+                m_ranges.pop_front();
+                continue;
+            }
+
+            for (; index + count < n && !front.isExhausted(); ++count) {
+                pendingInterests[index + count] = PendingInterest(
+                    front.next(), m_rdn->get(), front.getConsumerId());
+            }
+
+            if (!front.isExhausted()) {
+                m_ranges.emplace_back(std::move(front));
+            }
+            m_ranges.pop_front();
+        }
+
+        return count;
+    }
+
+  protected:
+    /**
+     * @brief Re-create the face with exponential backoff until it succeeds or
+     * the pipeline is closed. The forwarder state is lost, so all pending
+     * Interests are expressed again with new PIT tokens
+     *
+     * @return true The face is connected again
+     * @return false The pipeline was closed
+     */
+    bool reconnect() {
+        auto backoff = std::chrono::milliseconds(100);
+
+        while (!isClosed()) {
+            LOG_WARN("face disconnected. reconnecting in %ld ms",
+                     backoff.count());
+
+            auto until = std::chrono::steady_clock::now() + backoff;
+            while (!isClosed() && std::chrono::steady_clock::now() < until) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            if (!isClosed() && face->reconnect()) {
+                break;
+            }
+
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(10000));
+        }
+
+        if (isClosed()) {
+            return false;
+        }
+
+        m_disconnected = false;
+
+        for (auto &entry : *m_pit) {
+            auto pendingInterest = entry.second;
+            pendingInterest.refresh(m_rdn->get(), false);
+            m_requestQueue.enqueue(std::move(pendingInterest));
+        }
+
+        m_pit->clear();
+        while (!m_piq->empty()) {
+            m_piq->pop();
+        }
+
+        return true;
+    }
+
   private:
     virtual void open() = 0;
     virtual void onTimeout() = 0;
@@ -252,8 +441,13 @@ class PipelineInterests : public PacketHandler {
   private:
     RequestQueue m_requestQueue;
     ResponseQueues m_responseQueues;
+    std::shared_mutex m_responseQueuesMtx;
+
+    SegmentRangeQueue m_rangeQueue;
+    std::deque<SegmentRange> m_ranges; // owned by the worker thread
 
     std::atomic_bool m_closed;
+    std::atomic_bool m_disconnected;
     std::thread m_worker;
 };
 }; // namespace ndnc
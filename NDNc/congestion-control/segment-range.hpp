@@ -0,0 +1,89 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_CONGESTION_CONTROL_SEGMENT_RANGE_HPP
+#define NDNC_CONGESTION_CONTROL_SEGMENT_RANGE_HPP
+
+#include <ndn-cxx/util/time.hpp>
+
+#include "pipeline-common.hpp"
+
+namespace ndnc {
+/**
+ * @brief A request for segments [first, last] of a versioned Name. The
+ * pipeline worker generates the Interest packets lazily, as the congestion
+ * window opens, instead of having them materialized up-front by the caller
+ *
+ */
+class SegmentRange {
+  public:
+    SegmentRange() {
+    }
+
+    SegmentRange(const ndn::Name &name, uint64_t first, uint64_t last,
+                 ndn::time::milliseconds interestLifetime, uint64_t consumerId)
+        : m_name{name}, m_next{first}, m_last{last},
+          m_interestLifetime{interestLifetime}, m_consumerId{consumerId} {
+    }
+
+    ~SegmentRange() {
+    }
+
+    uint64_t getConsumerId() const {
+        return m_consumerId;
+    }
+
+    bool isExhausted() const {
+        return m_next > m_last;
+    }
+
+    uint64_t getRemainingCount() const {
+        return isExhausted() ? 0 : m_last - m_next + 1;
+    }
+
+    /**
+     * @brief Build the Interest packet for the next segment in range
+     *
+     * @return std::shared_ptr<ndn::Interest> The Interest packet
+     */
+    std::shared_ptr<ndn::Interest> next() {
+        auto interest = std::make_shared<ndn::Interest>(
+            ndn::Name(m_name).appendSegment(m_next++));
+        interest->setInterestLifetime(m_interestLifetime);
+        return interest;
+    }
+
+  private:
+    ndn::Name m_name;
+    uint64_t m_next = 1;
+    uint64_t m_last = 0;
+    ndn::time::milliseconds m_interestLifetime;
+    uint64_t m_consumerId = 0;
+};
+}; // namespace ndnc
+
+#endif // NDNC_CONGESTION_CONTROL_SEGMENT_RANGE_HPP
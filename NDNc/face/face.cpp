@@ -31,7 +31,8 @@
 namespace ndnc {
 namespace face {
 Face::Face()
-    : m_transport{nullptr}, m_packetHandler{nullptr}, m_hasError{false} {
+    : m_transport{nullptr}, m_packetHandler{nullptr}, m_hasError{false},
+      m_dataroom{0}, m_gqlserver{}, m_appName{}, m_prefixes{} {
     m_gqlClient = std::make_shared<mgmt::Client>();
 }
 
@@ -44,6 +45,10 @@ Face::~Face() {
 }
 
 bool Face::connect(int dataroom, std::string gqlserver, std::string appName) {
+    m_dataroom = dataroom;
+    m_gqlserver = gqlserver;
+    m_appName = appName;
+
     if (!m_gqlClient->createFace(0, dataroom, gqlserver)) {
         return false;
     }
@@ -79,7 +84,31 @@ bool Face::isConnected() {
 }
 
 void Face::disconnect() {
-    this->onDisconnect();
+    if (this->onDisconnect != nullptr) {
+        this->onDisconnect();
+    }
+}
+
+bool Face::reconnect() {
+    // The old face is most likely gone with the forwarder; best effort
+    m_gqlClient->deleteFace();
+    m_transport = nullptr;
+    m_hasError = false;
+
+    m_gqlClient = std::make_shared<mgmt::Client>();
+    if (!connect(m_dataroom, m_gqlserver, m_appName)) {
+        return false;
+    }
+
+    for (auto &prefix : m_prefixes) {
+        if (!m_gqlClient->insertFibEntry(prefix)) {
+            LOG_ERROR("unable to advertise prefix=%s", prefix.c_str());
+            return false;
+        }
+    }
+
+    LOG_INFO("face reconnected");
+    return true;
 }
 
 bool Face::loop() {
@@ -109,7 +138,12 @@ bool Face::advertise(const std::string prefix) {
         return false;
     }
 
-    return m_gqlClient->insertFibEntry(prefix);
+    if (!m_gqlClient->insertFibEntry(prefix)) {
+        return false;
+    }
+
+    m_prefixes.push_back(prefix);
+    return true;
 }
 
 int Face::send(const ndn::Block pkt) {
@@ -120,6 +154,18 @@ int Face::send(const std::vector<ndn::Block> *pkts, uint16_t n) {
     return m_transport->send(pkts, n);
 }
 
+uint8_t *Face::reserve(size_t len) {
+    return m_transport->reserve(len);
+}
+
+void Face::commit(size_t len) {
+    m_transport->commit(len);
+}
+
+int Face::flush() {
+    return m_transport->flush();
+}
+
 void Face::receive(const ndn::Block &&pkt) {
     ndn::lp::Packet lpPacket = ndn::lp::Packet(pkt);
     auto frag = lpPacket.get<ndn::lp::FragmentField>();
@@ -30,6 +30,7 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 #if (!defined(__APPLE__) && !defined(__MACH__))
 #include "memif.hpp"
 #else
@@ -53,11 +54,30 @@ class Face {
     bool isConnected();
     void disconnect();
 
+    /**
+     * @brief Re-create the face on the forwarder and re-establish the memif
+     * connection with the parameters of the last connect, then advertise
+     * again all prefixes. Used after the forwarder restarted
+     *
+     * @return true The face is connected again
+     * @return false Unable to re-create the face
+     */
+    bool reconnect();
+
     bool loop();
 
     int send(const ndn::Block pkt);
     int send(const std::vector<ndn::Block> *pkts, uint16_t n);
 
+    /**
+     * @brief Encode packets in place in the transport TX buffers. See
+     * Transport::reserve, Transport::commit and Transport::flush
+     *
+     */
+    uint8_t *reserve(size_t len);
+    void commit(size_t len);
+    int flush();
+
     bool advertise(const std::string prefix);
 
     bool addPacketHandler(PacketHandler &h);
@@ -78,6 +98,14 @@ class Face {
 
     PacketHandler *m_packetHandler;
     bool m_hasError;
+
+    // Parameters of the last connect and advertised prefixes, kept to
+    // re-create the face
+    int m_dataroom;
+    std::string m_gqlserver;
+    std::string m_appName;
+    std::vector<std::string> m_prefixes;
+
     std::function<void()> onDisconnect = nullptr;
 };
 }; // namespace face
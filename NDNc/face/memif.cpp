@@ -42,7 +42,7 @@ Memif::Memif(uint16_t dataroom, const char *socketPath, const char *appName)
 }
 
 Memif::~Memif() {
-    if (m_conn == nullptr) {
+    if (m_conn != nullptr) {
         m_conn->is_connected = 0;
 
         if (m_conn->tx_bufs != nullptr) {
@@ -64,6 +64,7 @@ Memif::~Memif() {
         }
 
         free(m_conn);
+        m_conn = nullptr;
     }
 
     if (m_socket != nullptr) {
@@ -173,6 +174,11 @@ int Memif::send(const ndn::Block pkt) noexcept {
         return -1;
     }
 
+    // Reserved packets go out first, the TX buffers are reused below
+    if (m_conn->tx_buf_num > 0 && flush() < 0) {
+        return -1;
+    }
+
     if (m_conn->tx_buf_num >= MAX_MEMIF_TX_BUFS) {
         LOG_ERROR("memif send drop=max-memif-tx-bufs-exceeded num=%d",
                   m_conn->tx_buf_num);
@@ -223,6 +229,10 @@ int Memif::send(const std::vector<ndn::Block> *pkts, uint16_t n) noexcept {
         return -1;
     }
 
+    if (m_conn->tx_buf_num > 0 && flush() < 0) {
+        return -1;
+    }
+
     if (m_conn->tx_buf_num >= MAX_MEMIF_TX_BUFS) {
         LOG_ERROR("memif send drop=max-memif-tx-bufs-exceeded num=%d",
                   m_conn->tx_buf_num);
@@ -280,6 +290,60 @@ int Memif::send(const std::vector<ndn::Block> *pkts, uint16_t n) noexcept {
     return tx;
 }
 
+uint8_t *Memif::reserve(size_t len) noexcept {
+    if (!isConnected() || m_conn->tx_buf_num >= MAX_MEMIF_TX_BUFS ||
+        len > m_dataroom) {
+        return nullptr;
+    }
+
+    uint16_t allocated = 0;
+    int err = memif_buffer_alloc(m_conn->conn_handle, m_conn->tx_qid,
+                                 &m_conn->tx_bufs[m_conn->tx_buf_num], 1,
+                                 &allocated, pow2(len));
+
+    if ((err != MEMIF_ERR_SUCCESS && err != MEMIF_ERR_NOBUF_RING) ||
+        allocated == 0) {
+        LOG_ERROR("memif_buffer_alloc allocated: 0/1 bufs. err=%s",
+                  memif_strerror(err));
+        return nullptr;
+    }
+
+    auto &buf = m_conn->tx_bufs[m_conn->tx_buf_num];
+    m_conn->tx_buf_num += allocated;
+    return static_cast<uint8_t *>(buf.data);
+}
+
+void Memif::commit(size_t len) noexcept {
+    if (m_conn->tx_buf_num > 0) {
+        m_conn->tx_bufs[m_conn->tx_buf_num - 1].len = len;
+    }
+}
+
+int Memif::flush() noexcept {
+    if (m_conn->tx_buf_num == 0) {
+        return 0;
+    }
+
+    uint16_t n = m_conn->tx_buf_num;
+    uint16_t tx = 0;
+    int err = memif_tx_burst(m_conn->conn_handle, m_conn->tx_qid,
+                             m_conn->tx_bufs, n, &tx);
+    m_conn->tx_buf_num -= tx;
+
+    if (err != MEMIF_ERR_SUCCESS) {
+        LOG_ERROR("memif_tx_burst transmitted: %d/%d pkts. err=%s", tx, n,
+                  memif_strerror(err));
+        return -1;
+    }
+
+    if (m_conn->tx_buf_num > 0) {
+        LOG_FATAL("memif_tx_burst err=failed-to-send-allocated-packets");
+        return -1;
+    }
+
+    return tx;
+}
+
 int Memif::handleConnect(memif_conn_handle_t conn_handle, void *ctx) {
     auto conn = reinterpret_cast<memif_connection_t *>(ctx);
 
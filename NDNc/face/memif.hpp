@@ -56,6 +56,9 @@ class Memif : public Transport {
     bool loop() noexcept final;
     int send(const ndn::Block pkt) noexcept final;
     int send(const std::vector<ndn::Block> *pkts, uint16_t n) noexcept final;
+    uint8_t *reserve(size_t len) noexcept final;
+    void commit(size_t len) noexcept final;
+    int flush() noexcept final;
 
   private:
     static int handleConnect(memif_conn_handle_t conn_handle, void *ctx);
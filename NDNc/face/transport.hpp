@@ -50,6 +50,33 @@ class Transport {
     virtual int send(const std::vector<ndn::Block> *pkts,
                      uint16_t n) noexcept = 0;
 
+    /**
+     * @brief Reserve room for one packet of up to len bytes in the TX ring,
+     * for the caller to encode the packet in place. Reserved packets are sent
+     * by flush() or before the next send()
+     *
+     * @return uint8_t* The packet buffer or nullptr if nothing can be reserved
+     */
+    virtual uint8_t *reserve(size_t) noexcept {
+        return nullptr;
+    }
+
+    /**
+     * @brief Set the final length of the last reserved packet
+     *
+     */
+    virtual void commit(size_t) noexcept {
+    }
+
+    /**
+     * @brief Send all reserved packets
+     *
+     * @return int The number of packets sent or -1 on error
+     */
+    virtual int flush() noexcept {
+        return 0;
+    }
+
     void setOnDisconnectCallback(OnDisconnectCallback cb, void *ctx) noexcept {
         this->onDisconnectCtx = ctx;
         this->onDisconnect = cb;
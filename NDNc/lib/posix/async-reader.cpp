@@ -0,0 +1,220 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <optional>
+
+#include "async-reader.hpp"
+#include "consumer.hpp"
+#include "logger/logger.hpp"
+
+namespace ndnc::posix {
+AsyncReader::AsyncReader(Consumer &consumer)
+    : consumer_{consumer}, cache_{consumer.getSegmentCache()},
+      id_{consumer.registerConsumer()}, submitQueue_{}, waiters_{},
+      stopped_{false} {
+    worker_ = std::thread(&AsyncReader::run, this);
+}
+
+AsyncReader::~AsyncReader() {
+    stop();
+}
+
+void AsyncReader::stop() {
+    if (stopped_.exchange(true)) {
+        return;
+    }
+    consumer_.wakeup(id_);
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    drain();
+
+    consumer_.unregisterConsumer(id_);
+}
+
+bool AsyncReader::submit(const ndn::Name &name,
+                         std::unique_ptr<ReorderBuffer> buffer,
+                         OnComplete onComplete) {
+    if (stopped_ || !consumer_.isValid()) {
+        return false;
+    }
+
+    auto wire = name.wireEncode();
+    if (!submitQueue_.enqueue(std::make_shared<Read>(
+            Read{name, std::string(wire.begin(), wire.end()),
+                 std::move(buffer), std::move(onComplete)}))) {
+        return false;
+    }
+
+    // The completion thread may be waiting for Data, start the read now
+    consumer_.wakeup(id_);
+    return true;
+}
+
+void AsyncReader::run() {
+    std::vector<std::shared_ptr<Read>> reads(64);
+    std::vector<std::shared_ptr<ndn::Data>> pkts(64);
+
+    while (!stopped_ && consumer_.isValid()) {
+        auto nreads =
+            submitQueue_.try_dequeue_bulk(reads.begin(), reads.size());
+        for (size_t i = 0; i < nreads; ++i) {
+            if (!start(reads[i])) {
+                complete(reads[i], -1);
+                failAll();
+            }
+            reads[i] = nullptr;
+        }
+
+        // Blocks until Data arrives or submit() wakes the thread up
+        auto npkts = consumer_.getData(pkts, id_);
+        for (size_t i = 0; i < npkts; ++i) {
+            if (pkts[i] == nullptr) {
+                // The failed segment is unknown; fail every pending read
+                LOG_ERROR("pipeline error on async read");
+                failAll();
+                continue;
+            }
+
+            if (!pkts[i]->getName().empty()) {
+                receive(pkts[i]);
+            }
+        }
+    }
+
+    failAll();
+    drain();
+}
+
+void AsyncReader::drain() {
+    // Fail the reads submitted but not started
+    std::shared_ptr<Read> read;
+    while (submitQueue_.try_dequeue(read)) {
+        complete(read, -1);
+    }
+}
+
+bool AsyncReader::start(const std::shared_ptr<Read> &read) {
+    auto &buffer = *read->buffer;
+
+    if (buffer.isComplete()) {
+        complete(read, buffer.getContiguousBytes());
+        return true;
+    }
+
+    // Request each run of segments nobody is waiting for as one range
+    std::optional<uint64_t> runFirst;
+    auto flush = [&](uint64_t runLast) {
+        if (runFirst.has_value()) {
+            if (!consumer_.asyncRequestSegmentRange(read->name, *runFirst,
+                                                    runLast, id_)) {
+                return false;
+            }
+            runFirst.reset();
+        }
+        return true;
+    };
+
+    for (auto segment = buffer.getFirstSegment();
+         segment <= buffer.getLastSegment(); ++segment) {
+        if (buffer.has(segment)) {
+            if (!flush(segment - 1)) {
+                return false;
+            }
+            continue;
+        }
+
+        auto &waiters = waiters_[{read->key, segment}];
+        if (!waiters.empty()) {
+            if (!flush(segment - 1)) {
+                return false;
+            }
+        } else if (!runFirst.has_value()) {
+            runFirst = segment;
+        }
+
+        waiters.push_back(read);
+    }
+
+    return flush(buffer.getLastSegment());
+}
+
+void AsyncReader::receive(const std::shared_ptr<ndn::Data> &data) {
+    if (!data->getName().at(-1).isSegment()) {
+        LOG_DEBUG("async read: Data packet is not a segment");
+        return;
+    }
+
+    auto segment = data->getName().at(-1).toSegment();
+    auto wire = data->getName().getPrefix(-1).wireEncode();
+    auto key = std::string(wire.begin(), wire.end());
+
+    if (cache_ != nullptr) {
+        cache_->put(key, segment, data);
+    }
+
+    auto it = waiters_.find({key, segment});
+    if (it == waiters_.end()) {
+        return;
+    }
+
+    auto waiters = std::move(it->second);
+    waiters_.erase(it);
+
+    for (auto &read : waiters) {
+        read->buffer->insert(data);
+
+        if (read->buffer->isComplete()) {
+            complete(read, read->buffer->getContiguousBytes());
+        }
+    }
+}
+
+void AsyncReader::complete(const std::shared_ptr<Read> &read,
+                           ssize_t result) {
+    if (read->onComplete == nullptr) {
+        return;
+    }
+
+    // Invoke the callback once, even if the read waits on several segments
+    auto onComplete = std::move(read->onComplete);
+    read->onComplete = nullptr;
+    onComplete(result);
+}
+
+void AsyncReader::failAll() {
+    auto waiters = std::move(waiters_);
+    waiters_.clear();
+
+    for (auto &[key, reads] : waiters) {
+        for (auto &read : reads) {
+            complete(read, -1);
+        }
+    }
+}
+}; // namespace ndnc::posix
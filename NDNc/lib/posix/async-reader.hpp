@@ -0,0 +1,117 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_POSIX_ASYNC_READER_HPP
+#define NDNC_LIB_POSIX_ASYNC_READER_HPP
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ndn-cxx/name.hpp>
+
+#include "congestion-control/concurrentqueue/concurrentqueue.h"
+#include "reorder-buffer.hpp"
+#include "segment-cache.hpp"
+
+namespace ndnc::posix {
+class Consumer;
+}; // namespace ndnc::posix
+
+namespace ndnc::posix {
+/**
+ * @brief Complete file reads asynchronously. Submitted reads only enqueue
+ * their segment ranges in the pipeline; a single completion thread receives
+ * the Data packets of all reads on one consumer id, scatters them into the
+ * waiting buffers and invokes the completion callback of every read that is
+ * done. Segments wanted by several reads are requested once
+ *
+ */
+class AsyncReader {
+  public:
+    /**
+     * @brief Called from the completion thread with the number of bytes read
+     * or -1 on error
+     *
+     */
+    using OnComplete = std::function<void(ssize_t result)>;
+
+  public:
+    AsyncReader(Consumer &consumer);
+    ~AsyncReader();
+
+    void stop();
+
+    /**
+     * @brief Submit a read
+     *
+     * @param name The versioned Name of the file
+     * @param buffer The destination buffer, possibly partially filled
+     * @param onComplete The completion callback
+     * @return true The read was submitted
+     * @return false The reader is stopped
+     */
+    bool submit(const ndn::Name &name, std::unique_ptr<ReorderBuffer> buffer,
+                OnComplete onComplete);
+
+  private:
+    struct Read {
+        ndn::Name name;
+        std::string key; // wire encoding of the versioned Name
+        std::unique_ptr<ReorderBuffer> buffer;
+        OnComplete onComplete;
+    };
+
+    using Waiters = std::vector<std::shared_ptr<Read>>;
+
+  private:
+    void run();
+    bool start(const std::shared_ptr<Read> &read);
+    void receive(const std::shared_ptr<ndn::Data> &data);
+    void complete(const std::shared_ptr<Read> &read, ssize_t result);
+    void failAll();
+    void drain();
+
+  private:
+    Consumer &consumer_;
+    std::shared_ptr<SegmentCache> cache_;
+    uint64_t id_;
+
+    moodycamel::ConcurrentQueue<std::shared_ptr<Read>> submitQueue_;
+    // Reads waiting for each segment; owned by the completion thread
+    std::map<std::pair<std::string, uint64_t>, Waiters> waiters_;
+
+    std::atomic_bool stopped_;
+    std::thread worker_;
+};
+}; // namespace ndnc::posix
+
+#endif // NDNC_LIB_POSIX_ASYNC_READER_HPP
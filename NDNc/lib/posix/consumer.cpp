@@ -30,10 +30,28 @@
 
 namespace ndnc::posix {
 Consumer::Consumer(ConsumerOptions options)
-    : options_{options}, face_{nullptr}, pipeline_{nullptr}, is_valid_{false},
-      error_{false} {
+    : Consumer(options,
+               options.segmentCacheSize > 0
+                   ? std::make_shared<SegmentCache>(options.segmentCacheSize)
+                   : nullptr,
+               options.metadataCacheTTL > ndn::time::milliseconds{0}
+                   ? std::make_shared<MetadataCache>(std::chrono::milliseconds{
+                         options.metadataCacheTTL.count()})
+                   : nullptr) {
+}
+
+Consumer::Consumer(ConsumerOptions options,
+                   std::shared_ptr<SegmentCache> segmentCache,
+                   std::shared_ptr<MetadataCache> metadataCache)
+    : options_{options}, face_{nullptr}, pipeline_{nullptr},
+      segmentCache_{segmentCache}, metadataCache_{metadataCache},
+      asyncReader_{nullptr}, is_valid_{false}, error_{false} {
     this->openFace();
     this->openPipeline();
+
+    if (pipeline_ != nullptr) {
+        asyncReader_ = std::make_shared<AsyncReader>(*this);
+    }
 }
 
 Consumer::~Consumer() {
@@ -41,6 +59,10 @@ Consumer::~Consumer() {
 }
 
 void Consumer::stop() {
+    if (asyncReader_ != nullptr) {
+        asyncReader_->stop();
+    }
+
     if (pipeline_ != nullptr && !pipeline_->isClosed()) {
         pipeline_->close();
     }
@@ -169,11 +191,64 @@ bool Consumer::asyncRequestDataFor(
     return true;
 }
 
+bool Consumer::asyncRequestSegmentRange(const ndn::Name &name, uint64_t first,
+                                        uint64_t last, uint64_t id) {
+    if (!pipeline_->pushSegmentRange(id, name, first, last,
+                                     options_.interestLifetime)) {
+        LOG_FATAL("unable to push segment range to pipeline");
+        error_ = true;
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<std::shared_ptr<ndn::Data>>
+Consumer::syncRequestSegmentRange(const ndn::Name &name, uint64_t first,
+                                  uint64_t last, uint64_t id) {
+    if (!asyncRequestSegmentRange(name, first, last, id)) {
+        return {};
+    }
+
+    // Data packets are placed at index (segment - first)
+    std::vector<std::shared_ptr<ndn::Data>> pkts(last - first + 1);
+
+    for (auto npkts = pkts.size(); npkts > 0; --npkts) {
+        std::shared_ptr<ndn::Data> pkt(nullptr);
+
+        while (this->isValid() && !pipeline_->popData(id, pkt)) {}
+
+        if (pkt == nullptr) {
+            return {};
+        }
+
+        if (!pkt->getName().at(-1).isSegment()) {
+            LOG_ERROR("last name component of Data packet is not a segment");
+            return {};
+        }
+
+        auto segment = pkt->getName().at(-1).toSegment();
+        if (segment < first || segment > last ||
+            pkts[segment - first] != nullptr) {
+            LOG_ERROR("unexpected Data packet segment=%ld", segment);
+            return {};
+        }
+
+        pkts[segment - first] = std::move(pkt);
+    }
+
+    return pkts;
+}
+
 size_t Consumer::getData(std::vector<std::shared_ptr<ndn::Data>> &pkts,
                          uint64_t id) {
     return pipeline_->popDataBulk(id, pkts);
 }
 
+void Consumer::wakeup(uint64_t id) {
+    pipeline_->wakeConsumer(id);
+}
+
 ndn::Name Consumer::getNamePrefix() {
     return options_.prefix;
 }
@@ -185,4 +260,16 @@ ndnc::PipelineCounters Consumer::getCounters() {
 ConsumerOptions Consumer::getOptions() {
     return this->options_;
 }
+
+std::shared_ptr<SegmentCache> Consumer::getSegmentCache() {
+    return this->segmentCache_;
+}
+
+std::shared_ptr<MetadataCache> Consumer::getMetadataCache() {
+    return this->metadataCache_;
+}
+
+std::shared_ptr<AsyncReader> Consumer::getAsyncReader() {
+    return this->asyncReader_;
+}
 } // namespace ndnc::posix
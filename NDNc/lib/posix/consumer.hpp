@@ -37,6 +37,9 @@
 
 #include "congestion-control/pipeline-interests-aimd.hpp"
 #include "congestion-control/pipeline-interests-fixed.hpp"
+#include "async-reader.hpp"
+#include "metadata-cache.hpp"
+#include "segment-cache.hpp"
 
 namespace ndnc::posix {
 struct ConsumerOptions {
@@ -59,6 +62,20 @@ struct ConsumerOptions {
     PipelineType pipelineType = PipelineType::aimd;
     // Pipeline size
     size_t pipelineSize = 32768;
+
+    // Number of segments fetched ahead of the current offset on sequential
+    // file reads. Set to 0 to disable read-ahead
+    size_t readAheadSegments = 1024;
+
+    // Maximum number of bytes held by the segment cache shared by all files
+    // opened with this consumer. Set to 0 to disable the cache
+    size_t segmentCacheSize = 256 * 1024 * 1024;
+
+    // Lifetime of the file and directory metadata cached by path, including
+    // negative answers. Set to 0 to disable the cache
+    ndn::time::milliseconds metadataCacheTTL{5000};
+    // Maximum number of metadata requests in flight when listing a directory
+    size_t metadataConcurrency = 256;
 };
 }; // namespace ndnc::posix
 
@@ -66,6 +83,14 @@ namespace ndnc::posix {
 class Consumer : public std::enable_shared_from_this<Consumer> {
   public:
     Consumer(ConsumerOptions options);
+    /**
+     * @brief Construct a new Consumer object sharing the caches of another
+     * one, e.g. across a pool of consumers with different faces
+     *
+     */
+    Consumer(ConsumerOptions options,
+             std::shared_ptr<SegmentCache> segmentCache,
+             std::shared_ptr<MetadataCache> metadataCache);
     ~Consumer();
 
     void stop();
@@ -88,12 +113,23 @@ class Consumer : public std::enable_shared_from_this<Consumer> {
     asyncRequestDataFor(std::vector<std::shared_ptr<ndn::Interest>> &&interests,
                         uint64_t id);
 
+    bool asyncRequestSegmentRange(const ndn::Name &name, uint64_t first,
+                                  uint64_t last, uint64_t id);
+
+    std::vector<std::shared_ptr<ndn::Data>>
+    syncRequestSegmentRange(const ndn::Name &name, uint64_t first,
+                            uint64_t last, uint64_t id);
+
     size_t getData(std::vector<std::shared_ptr<ndn::Data>> &pkts, uint64_t id);
+    void wakeup(uint64_t id);
 
   public:
     ndn::Name getNamePrefix();
     ndnc::PipelineCounters getCounters();
     ConsumerOptions getOptions();
+    std::shared_ptr<SegmentCache> getSegmentCache();
+    std::shared_ptr<MetadataCache> getMetadataCache();
+    std::shared_ptr<AsyncReader> getAsyncReader();
 
   private:
     void openFace();
@@ -103,6 +139,9 @@ class Consumer : public std::enable_shared_from_this<Consumer> {
     ConsumerOptions options_;
     std::unique_ptr<ndnc::face::Face> face_;
     std::shared_ptr<ndnc::PipelineInterests> pipeline_;
+    std::shared_ptr<SegmentCache> segmentCache_;
+    std::shared_ptr<MetadataCache> metadataCache_;
+    std::shared_ptr<AsyncReader> asyncReader_;
 
     std::atomic_bool is_valid_;
     std::atomic_bool error_;
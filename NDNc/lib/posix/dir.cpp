@@ -30,7 +30,7 @@
 namespace ndnc::posix {
 Dir::Dir(std::shared_ptr<Consumer> consumer)
     : consumer_{consumer},
-      metadata_(nullptr), path_{}, content_{}, onReadNextEntryPos_{0} {
+      metadata_(nullptr), path_{}, stream_{nullptr}, stream_id_{std::nullopt} {
 }
 
 Dir::~Dir() {
@@ -71,19 +71,30 @@ int Dir::stat(struct stat *buf) {
 }
 
 int Dir::read(char *buf, int blen) {
-    if (content_.empty() && !getDirContent()) {
+    if (stream_ == nullptr && !getDirContent()) {
         return -1;
     }
 
-    if (onReadNextEntryPos_ < content_.size()) {
-        memcpy(buf, content_[onReadNextEntryPos_].c_str(), blen);
-        ++onReadNextEntryPos_;
-    } else {
+    std::string_view entry;
+    auto ret = stream_->next(entry);
+
+    if (ret < 0) {
+        LOG_ERROR("unable to get the contents of dir '%s'", path_.c_str());
+        closeDirContent();
+        return -1;
+    }
+
+    if (ret == 0) {
+        // End of listing; the next read starts over
         buf[0] = '\0';
-        content_.clear();
-        onReadNextEntryPos_ = 0;
+        closeDirContent();
+        return 0;
     }
 
+    auto len = std::min(entry.size(), static_cast<size_t>(blen - 1));
+    memcpy(buf, entry.data(), len);
+    buf[len] = '\0';
+
     return 0;
 }
 
@@ -95,8 +106,7 @@ int Dir::close() {
 
     metadata_ = nullptr;
 
-    content_.clear();
-    onReadNextEntryPos_ = 0;
+    closeDirContent();
     path_.clear();
 
     return 0;
@@ -113,28 +123,12 @@ bool Dir::getDirMetadata(const char *path) {
         return -1;
     }
 
-    auto interest =
-        std::make_shared<ndn::Interest>(rdrDiscoveryNameFileRetrieval(
-            std::string(path), consumer_->getNamePrefix()));
-    interest->setCanBePrefix(true);
-    interest->setMustBeFresh(true);
-
+    // The listing is only versioned under the DIRECTORY LISTING Name
     auto id = consumer_->registerConsumer();
-    auto data = consumer_->syncRequestDataFor(std::move(interest), id);
+    metadata_ = Listing(consumer_).getMetadata(std::string(path), id, true);
     consumer_->unregisterConsumer(id);
 
-    if (data == nullptr || !data->hasContent()) {
-        LOG_ERROR("dir metadata: invalid data");
-        return false;
-    }
-
-    if (data->getContentType() == ndn::tlv::ContentType_Nack) {
-        LOG_ERROR("unable to list dir '%s'", path);
-        return false;
-    }
-
-    metadata_ = std::make_shared<FileMetadata>(data->getContent());
-    return true;
+    return metadata_ != nullptr;
 }
 
 bool Dir::getDirContent() {
@@ -148,65 +142,20 @@ bool Dir::getDirContent() {
         return -1;
     }
 
-    auto bytes = (uint8_t *)malloc(8800 * (metadata_->getFinalBlockID() + 1));
-    uint64_t offset = 0;
+    // Entries are parsed as the listing segments arrive
+    stream_id_ = consumer_->registerConsumer();
+    stream_ =
+        std::make_unique<ListingStream>(consumer_, metadata_, *stream_id_);
 
-    if (bytes == nullptr) {
-        LOG_FATAL("unable to allocate memory for reading dir contents");
-        return false;
-    }
-
-    auto id = consumer_->registerConsumer();
-
-    for (uint64_t i = 0, finalBlockId = 0; i <= finalBlockId; ++i) {
-        auto interest = std::make_shared<ndn::Interest>(
-            metadata_->getVersionedName().appendSegment(i));
-
-        auto data = consumer_->syncRequestDataFor(std::move(interest), id);
-
-        if (data == nullptr || !data->hasContent()) {
-            LOG_ERROR("read dir contents: invalid data");
-            consumer_->unregisterConsumer(id);
-            return false;
-        }
-
-        if (data->getContentType() == ndn::tlv::ContentType_Nack) {
-            LOG_FATAL("unable to get the contents of dir '%s'", path_.c_str());
-            consumer_->unregisterConsumer(id);
-            return false;
-        } else {
-            if (!data->getFinalBlock()->isSegment()) {
-                LOG_ERROR(
-                    "dir list data content FinalBlockId is not a segment");
-                consumer_->unregisterConsumer(id);
-                return false;
-            } else {
-                finalBlockId = data->getFinalBlock()->toSegment();
-            }
-        }
-
-        memcpy(bytes + offset, data->getContent().value(),
-               data->getContent().value_size());
-        offset += data->getContent().value_size();
-    }
-
-    consumer_->unregisterConsumer(id);
-
-    for (uint64_t i = 0, j = 0; i <= offset && j <= offset; ++j) {
-        if (bytes[j] != '\0') {
-            continue;
-        }
-
-        if (bytes[i] == '\0') {
-            break;
-        }
+    return true;
+}
 
-        content_.push_back(std::string((const char *)(bytes + i), j - i));
+void Dir::closeDirContent() {
+    stream_ = nullptr;
 
-        i = j + 1;
+    if (stream_id_.has_value()) {
+        consumer_->unregisterConsumer(*stream_id_);
+        stream_id_ = std::nullopt;
     }
-
-    free(bytes);
-    return true;
 }
 }; // namespace ndnc::posix
@@ -29,9 +29,11 @@
 #define NDNC_LIB_POSIX_DIR_HPP
 
 #include <iterator>
+#include <optional>
 
 #include "consumer.hpp"
 #include "file-metadata.hpp"
+#include "listing.hpp"
 
 namespace ndnc::posix {
 class Dir {
@@ -48,14 +50,15 @@ class Dir {
     bool isOpened();
     bool getDirMetadata(const char *path);
     bool getDirContent();
+    void closeDirContent();
 
   private:
     std::shared_ptr<Consumer> consumer_;
     std::shared_ptr<FileMetadata> metadata_;
 
     std::string path_;
-    std::vector<std::string> content_;
-    size_t onReadNextEntryPos_;
+    std::unique_ptr<ListingStream> stream_;
+    std::optional<uint64_t> stream_id_;
 };
 }; // namespace ndnc::posix
 
@@ -82,12 +82,24 @@ class FileMetadata {
         this->versionedName_ =
             name.appendVersion(timestamp_to_uint64(stx_.stx_mtime));
 
+        // The last segment number, not the number of segments
         this->finalBlockId_ =
-            (uint64_t)(ceil((double)stx_.stx_size / segmentSize_));
+            stx_.stx_size > 0 ? (stx_.stx_size - 1) / segmentSize_ : 0;
 
         return true;
     }
 
+    /**
+     * @brief Describe content other than the file itself, e.g. the listing of
+     * a directory, split into segments of the same segment size
+     *
+     * @param size The content size
+     */
+    void setContentSize(uint64_t size) {
+        this->stx_.stx_size = size;
+        this->finalBlockId_ = size > 0 ? (size - 1) / segmentSize_ : 0;
+    }
+
     ndn::Block encode() {
         ndn::Block content(ndn::tlv::Content);
 
@@ -36,6 +36,13 @@ static const ndn::Name::Component metadataComponent =
     ndn::Name::Component::fromEscapedString("32=metadata");
 static const ndn::Name::Component lsComponent =
     ndn::Name::Component::fromEscapedString("32=ls");
+static const ndn::Name::Component checksumComponent =
+    ndn::Name::Component::fromEscapedString("32=checksum");
+
+// ContentType of a file checksum packet sent while the checksum is still
+// being computed. The Content is a NonNegativeInteger, the number of
+// milliseconds to wait before asking again
+static const uint32_t checksumPendingContentType = 0x4E00;
 }; // namespace ndnc::posix
 
 namespace ndnc::posix {
@@ -70,6 +77,88 @@ rdrDiscoveryNameDirListing(const std::string path, const ndn::Name prefix) {
         .append(metadataComponent);
 }
 
+/**
+ * @brief Get the Name of a file checksum packet, an NDNc extension next to the
+ * RDR discovery Name: <prefix>/<path>/32=checksum/<algorithm>. The Data
+ * content is the checksum in lowercase hex, or a retry-after hint with the
+ * checksumPendingContentType
+ *
+ * @param path The file path
+ * @param algorithm The checksum algorithm, e.g. adler32 or crc32c
+ * @param prefix The Name prefix
+ * @return const ndn::Name The NDN packet Name
+ */
+inline static const ndn::Name rdrChecksumName(const std::string path,
+                                              const std::string algorithm,
+                                              const ndn::Name prefix) {
+    return prefix.deepCopy()
+        .append(path)
+        .append(checksumComponent)
+        .append(algorithm);
+}
+
+/**
+ * @brief Check if the NDN Name corresponds to a file checksum packet Name
+ *
+ * @param name The NDN packet Name
+ * @return true
+ * @return false
+ */
+inline static bool isRDRChecksumName(const ndn::Name name) {
+    return name.size() >= 2 && name.at(-2) == checksumComponent;
+}
+
+/**
+ * @brief Get the path named by the components of a Name, from their decoded
+ * values. Components that are empty, "." or "..", or hold a '/' or a NUL
+ * byte, would not name a single path element and are rejected
+ *
+ * @param name The path part of the NDN packet Name
+ * @return const std::string The path, or empty if rejected
+ */
+inline static const std::string rdrPath(const ndn::Name name) {
+    std::string path;
+
+    for (const auto &component : name) {
+        std::string value(reinterpret_cast<const char *>(component.value()),
+                          component.value_size());
+
+        if (value.empty() || value == "." || value == ".." ||
+            value.find_first_of(std::string("/\0", 2)) != std::string::npos) {
+            return "";
+        }
+
+        path += "/" + value;
+    }
+
+    return path.empty() ? "/" : path;
+}
+
+/**
+ * @brief Get the file path from a file content packet Name:
+ * <prefix>/<path>/<version>/<segment>
+ *
+ * @param name The NDN packet Name
+ * @param prefix The Name prefix
+ * @return const std::string The file path
+ */
+inline static const std::string rdrFileContentUri(const ndn::Name name,
+                                                  const ndn::Name prefix) {
+    return rdrPath(name.getPrefix(-2).getSubName(prefix.size()));
+}
+
+/**
+ * @brief Get the file path from a file checksum packet Name
+ *
+ * @param name The NDN packet Name
+ * @param prefix The Name prefix
+ * @return const std::string The file path
+ */
+inline static const std::string rdrChecksumFileUri(const ndn::Name name,
+                                                   const ndn::Name prefix) {
+    return rdrPath(name.getPrefix(-2).getSubName(prefix.size()));
+}
+
 /**
  * @brief Check if the NDN Name corresponds to a RDR discovery packet Name
  * https://redmine.named-data.net/projects/ndn-tlv/wiki/RDR
@@ -94,7 +183,33 @@ inline static bool isRDRDiscoveryName(const ndn::Name name) {
  */
 inline static const std::string rdrFileUri(const ndn::Name name,
                                            const ndn::Name prefix) {
-    return name.getPrefix(-1).getSubName(prefix.size()).toUri();
+    return rdrPath(name.getPrefix(-1).getSubName(prefix.size()));
+}
+
+/**
+ * @brief Check if the NDN Name corresponds to a DIRECTORY LISTING RDR
+ * discovery packet Name: <prefix>/<path>/32=ls/32=metadata
+ *
+ * @param name The NDN packet Name
+ * @return true
+ * @return false
+ */
+inline static bool isRDRDirListingName(const ndn::Name name) {
+    return isRDRDiscoveryName(name) && name.size() >= 2 &&
+           name.at(-2) == lsComponent;
+}
+
+/**
+ * @brief Check if the NDN Name corresponds to a DIRECTORY LISTING content
+ * packet Name: <prefix>/<path>/32=ls/<version>/<segment>
+ *
+ * @param name The NDN packet Name
+ * @return true
+ * @return false
+ */
+inline static bool isRDRDirListingContentName(const ndn::Name name) {
+    return name.size() >= 3 && name.at(-1).isSegment() &&
+           name.at(-2).isVersion() && name.at(-3) == lsComponent;
 }
 
 /**
@@ -108,7 +223,19 @@ inline static const std::string rdrFileUri(const ndn::Name name,
  */
 inline static const std::string rdrDirUri(const ndn::Name name,
                                           const ndn::Name prefix) {
-    return name.getPrefix(-2).getSubName(prefix.size()).toUri();
+    return rdrPath(name.getPrefix(-2).getSubName(prefix.size()));
+}
+
+/**
+ * @brief Get the directory path from a DIRECTORY LISTING content packet Name
+ *
+ * @param name The NDN packet Name
+ * @param prefix The Name prefix
+ * @return const std::string The directory path
+ */
+inline static const std::string rdrDirListingUri(const ndn::Name name,
+                                                 const ndn::Name prefix) {
+    return rdrPath(name.getPrefix(-3).getSubName(prefix.size()));
 }
 }; // namespace ndnc::posix
 
@@ -26,7 +26,10 @@
  */
 
 #include <algorithm>
-#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <iterator>
+#include <thread>
 
 #include "file.hpp"
 #include "logger/logger.hpp"
@@ -34,7 +37,8 @@
 namespace ndnc::posix {
 File::File(std::shared_ptr<Consumer> consumer)
     : consumer_{consumer}, metadata_{nullptr}, reporter_{nullptr}, path_{},
-      consumer_ids_{} {
+      cache_{nullptr}, cache_key_{}, consumer_ids_{}, read_id_{std::nullopt},
+      next_offset_{0}, read_ahead_to_{0}, segments_{}, inflight_{} {
 
     if (!consumer_->getOptions().influxdb.empty()) {
         this->reporter_ = std::make_unique<ndnc::MeasurementsReporter>(256);
@@ -62,6 +66,10 @@ int File::open(const char *path) {
     }
 
     path_ = std::string(path);
+
+    cache_ = consumer_->getSegmentCache();
+    auto wire = metadata_->getVersionedName().wireEncode();
+    cache_key_ = std::string(wire.begin(), wire.end());
     return 0;
 }
 
@@ -81,6 +89,8 @@ int File::close() {
 
     metadata_ = nullptr;
     path_.clear();
+    cache_ = nullptr;
+    cache_key_.clear();
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -90,6 +100,19 @@ int File::close() {
         consumer_ids_.clear();
     }
 
+    {
+        std::lock_guard<std::mutex> lock(read_mutex_);
+        if (read_id_.has_value()) {
+            consumer_->unregisterConsumer(*read_id_);
+            read_id_.reset();
+        }
+
+        next_offset_ = 0;
+        read_ahead_to_ = 0;
+        segments_.clear();
+        inflight_.clear();
+    }
+
     return 0;
 }
 
@@ -117,61 +140,424 @@ int File::fstat(struct stat *buf) {
     return 0;
 }
 
-ssize_t File::read(void *buf, off_t offset, size_t blen) {
-    if (!isOpened()) {
+int File::checksum(const char *path, const std::string &algorithm,
+                   std::string &value) {
+    if (consumer_ == nullptr) {
+        LOG_ERROR("null consumer object");
         return -1;
     }
-    auto indexFirstSegment = offset / metadata_->getSegmentSize();
-    auto indexLastSegment = ceil(
-        (offset + blen) / static_cast<double>(metadata_->getSegmentSize()));
 
-    std::vector<std::shared_ptr<ndn::Interest>> pkts;
-    for (auto segment = indexFirstSegment; segment < indexLastSegment;
-         ++segment) {
-        auto interest = std::make_shared<ndn::Interest>(
-            metadata_->getVersionedName().deepCopy().appendSegment(segment));
-        pkts.emplace_back(std::move(interest));
+    // Computed by the producer; the file content is not transferred. Large
+    // files take a while, the producer answers with a retry-after hint until
+    // the checksum is ready
+    auto deadline = std::chrono::steady_clock::now() + checksumMaxWait;
+    std::shared_ptr<ndn::Data> data;
+
+    while (true) {
+        auto interest = std::make_shared<ndn::Interest>(rdrChecksumName(
+            std::string(path), algorithm, consumer_->getNamePrefix()));
+        interest->setCanBePrefix(true);
+        interest->setMustBeFresh(true);
+
+        data =
+            consumer_->syncRequestDataFor(std::move(interest), getConsumerId());
+
+        if (data == nullptr || !data->hasContent()) {
+            LOG_ERROR("file checksum: invalid data");
+            return -1;
+        }
+
+        if (data->getContentType() != checksumPendingContentType) {
+            break;
+        }
+
+        auto retryAfter = std::chrono::milliseconds(
+            ndn::readNonNegativeInteger(data->getContent()));
+        if (std::chrono::steady_clock::now() + retryAfter > deadline) {
+            LOG_ERROR("the %s checksum of file '%s' is not ready in time",
+                      algorithm.c_str(), path);
+            return -ETIMEDOUT;
+        }
+
+        std::this_thread::sleep_for(retryAfter);
     }
 
-    auto response =
-        consumer_->syncRequestDataFor(std::move(pkts), getConsumerId());
-    if (response.empty()) {
+    if (data->getContentType() == ndn::tlv::ContentType_Nack) {
+        LOG_ERROR("unable to get the %s checksum of file '%s'",
+                  algorithm.c_str(), path);
+        return -ENOENT;
+    }
+
+    auto content = data->getContent();
+    value.assign(reinterpret_cast<const char *>(content.value()),
+                 content.value_size());
+    return 0;
+}
+
+ssize_t File::read(void *buf, off_t offset, size_t blen,
+                   ReorderBuffer::OnProgress onProgress) {
+    if (!isOpened() || offset < 0) {
         return -1;
     }
 
-    std::sort(response.begin(), response.end(),
-              [](const std::shared_ptr<ndn::Data> data1,
-                 const std::shared_ptr<ndn::Data> data2) {
-                  return data1->getName().at(-1).toSegment() <
-                         data2->getName().at(-1).toSegment();
-              });
+    if (static_cast<uint64_t>(offset) >= metadata_->getFileSize()) {
+        return 0;
+    }
+
+    blen = std::min(blen, metadata_->getFileSize() - offset);
+    if (blen == 0) {
+        return 0;
+    }
 
-    ssize_t n = 0;
-    auto blen_copy = blen;
+    std::lock_guard<std::mutex> lock(read_mutex_);
 
-    auto copyDataContent = [&](const ndn::Block &block, size_t off) {
-        auto len = std::min(block.value_size() - off, blen);
-        memcpy((uint8_t *)buf + n, block.value() + off, len);
-        n += len;
-        blen -= len;
-    };
+    if (!read_id_.has_value()) {
+        read_id_ = consumer_->registerConsumer();
+    }
 
-    auto it = response.begin();
-    copyDataContent(it->get()->getContent(),
-                    offset % metadata_->getSegmentSize());
-    ++it;
+    ReorderBuffer buffer{buf, offset, blen, metadata_->getSegmentSize(),
+                         onProgress};
+    auto first = buffer.getFirstSegment();
+    auto last = buffer.getLastSegment();
+
+    // Serve the segments already received by read-ahead or cached by any of
+    // the files opened with the same consumer
+    for (auto segment = first; segment <= last; ++segment) {
+        if (auto it = segments_.find(segment); it != segments_.end()) {
+            buffer.insert(it->second);
+            segments_.erase(it);
+            continue;
+        }
 
-    for (; it != response.end(); ++it) {
-        copyDataContent(it->get()->getContent(), 0);
+        std::shared_ptr<ndn::Data> data;
+        if (cache_ != nullptr && cache_->get(cache_key_, segment, data)) {
+            buffer.insert(data);
+        }
     }
 
+    // Request the segments which are neither received nor in flight
+    if (!requestSegments(first, last, &buffer)) {
+        return -1;
+    }
+
+    // Keep the read-ahead window open on sequential access
+    if (offset == next_offset_) {
+        if (!readAhead(last)) {
+            return -1;
+        }
+    } else {
+        read_ahead_to_ = 0;
+    }
+
+    std::vector<std::shared_ptr<ndn::Data>> pkts(64);
+    bool hasError = false;
+
+    while (!hasError && !buffer.isComplete() && consumer_->isValid()) {
+        auto npkts = consumer_->getData(pkts, *read_id_);
+
+        for (size_t i = 0; i < npkts && !hasError; ++i) {
+            if (pkts[i] == nullptr || !pkts[i]->getName().at(-1).isSegment()) {
+                hasError = true;
+                break;
+            }
+
+            auto segment = pkts[i]->getName().at(-1).toSegment();
+            inflight_.erase(segment);
+
+            if (cache_ != nullptr) {
+                cache_->put(cache_key_, segment, pkts[i]);
+            }
+
+            if (segment >= first && segment <= last) {
+                buffer.insert(pkts[i]);
+            } else if (segment > last) {
+                segments_.emplace(segment, std::move(pkts[i]));
+            }
+        }
+    }
+
+    if (hasError) {
+        LOG_ERROR("pipeline error on read file '%s'", path_.c_str());
+        // The failed segments are unknown; let them be requested again
+        inflight_.clear();
+    }
+
+    // Drop the segments behind the current offset and bound the memory used
+    // by segments received out of the read-ahead window
+    segments_.erase(segments_.begin(), segments_.lower_bound(first));
+    while (segments_.size() > 2 * consumer_->getOptions().readAheadSegments) {
+        segments_.erase(std::prev(segments_.end()));
+    }
+
+    next_offset_ = offset + buffer.getContiguousBytes();
+
     if (reporter_ != nullptr) {
         auto counters = consumer_->getCounters();
-        reporter_->write(counters.tx, counters.rx, blen_copy,
+        reporter_->write(counters.tx, counters.rx,
+                         buffer.getContiguousBytes(),
                          counters.getAverageDelay().count());
     }
 
-    return n;
+    // Return the contiguous prefix on a partial read
+    if (!buffer.isComplete() && buffer.getContiguousBytes() == 0) {
+        return -1;
+    }
+
+    return buffer.getContiguousBytes();
+}
+
+ssize_t File::readv(const std::vector<ReadRange> &ranges) {
+    if (!isOpened()) {
+        return -EBADF;
+    }
+
+    // As XrdOssDF::ReadV, a chunk that can not be filled completely fails the
+    // whole vector rather than coming back short
+    auto size = metadata_->getFileSize();
+    for (auto &range : ranges) {
+        if (range.offset < 0) {
+            return -EINVAL;
+        }
+
+        auto offset = static_cast<uint64_t>(range.offset);
+        if (offset > size || range.blen > size - offset) {
+            LOG_ERROR("readv chunk of %zu bytes at offset=%lu past the end of "
+                      "file '%s'",
+                      range.blen, offset, path_.c_str());
+            return -ESPIPE;
+        }
+    }
+
+    std::vector<std::unique_ptr<ReorderBuffer>> buffers;
+    buffers.reserve(ranges.size());
+
+    // Buffers covering each segment of the batch
+    std::map<uint64_t, std::vector<ReorderBuffer *>> wanted;
+
+    for (auto &range : ranges) {
+        buffers.push_back(std::make_unique<ReorderBuffer>(
+            range.buf, range.offset, range.blen, metadata_->getSegmentSize()));
+
+        if (range.blen == 0) {
+            continue;
+        }
+
+        auto buffer = buffers.back().get();
+        for (auto segment = buffer->getFirstSegment();
+             segment <= buffer->getLastSegment(); ++segment) {
+            wanted[segment].push_back(buffer);
+        }
+    }
+
+    auto isComplete = [&buffers]() {
+        return std::all_of(buffers.begin(), buffers.end(),
+                           [](auto &buffer) { return buffer->isComplete(); });
+    };
+
+    std::lock_guard<std::mutex> lock(read_mutex_);
+
+    if (!read_id_.has_value()) {
+        read_id_ = consumer_->registerConsumer();
+    }
+
+    // Serve the segments already received or cached, then request all the
+    // remaining ones at once
+    std::set<uint64_t> missing;
+    for (auto &[segment, targets] : wanted) {
+        std::shared_ptr<ndn::Data> data;
+
+        if (auto it = segments_.find(segment); it != segments_.end()) {
+            data = it->second;
+        } else if (cache_ == nullptr ||
+                   !cache_->get(cache_key_, segment, data)) {
+            missing.insert(segment);
+            continue;
+        }
+
+        for (auto buffer : targets) {
+            buffer->insert(data);
+        }
+    }
+
+    if (!requestSegments(missing)) {
+        return -EIO;
+    }
+
+    std::vector<std::shared_ptr<ndn::Data>> pkts(64);
+    bool hasError = false;
+
+    while (!hasError && !isComplete() && consumer_->isValid()) {
+        auto npkts = consumer_->getData(pkts, *read_id_);
+
+        for (size_t i = 0; i < npkts; ++i) {
+            if (pkts[i] == nullptr || !pkts[i]->getName().at(-1).isSegment()) {
+                hasError = true;
+                break;
+            }
+
+            auto segment = pkts[i]->getName().at(-1).toSegment();
+            inflight_.erase(segment);
+
+            if (cache_ != nullptr) {
+                cache_->put(cache_key_, segment, pkts[i]);
+            }
+
+            // Scatter the content into every range covering the segment
+            if (auto it = wanted.find(segment); it != wanted.end()) {
+                for (auto buffer : it->second) {
+                    buffer->insert(pkts[i]);
+                }
+            } else {
+                segments_.emplace(segment, std::move(pkts[i]));
+            }
+        }
+    }
+
+    if (hasError) {
+        LOG_ERROR("pipeline error on readv file '%s'", path_.c_str());
+        // The failed segments are unknown; let them be requested again
+        inflight_.clear();
+    }
+
+    while (segments_.size() > 2 * consumer_->getOptions().readAheadSegments) {
+        segments_.erase(std::prev(segments_.end()));
+    }
+
+    if (!isComplete()) {
+        return -EIO;
+    }
+
+    ssize_t total = 0;
+    for (auto &buffer : buffers) {
+        total += buffer->getContiguousBytes();
+    }
+
+    return total;
+}
+
+int File::readAsync(void *buf, off_t offset, size_t blen,
+                    AsyncReader::OnComplete onComplete) {
+    if (!isOpened() || offset < 0) {
+        return -1;
+    }
+
+    auto size = metadata_->getFileSize();
+    blen = static_cast<uint64_t>(offset) < size
+               ? std::min(blen, size - static_cast<uint64_t>(offset))
+               : 0;
+
+    auto buffer = std::make_unique<ReorderBuffer>(buf, offset, blen,
+                                                  metadata_->getSegmentSize());
+
+    if (cache_ != nullptr) {
+        for (auto segment = buffer->getFirstSegment();
+             blen > 0 && segment <= buffer->getLastSegment(); ++segment) {
+            std::shared_ptr<ndn::Data> data;
+            if (cache_->get(cache_key_, segment, data)) {
+                buffer->insert(data);
+            }
+        }
+    }
+
+    if (buffer->isComplete()) {
+        onComplete(buffer->getContiguousBytes());
+        return 0;
+    }
+
+    auto reader = consumer_->getAsyncReader();
+    if (reader == nullptr || !reader->submit(metadata_->getVersionedName(),
+                                             std::move(buffer), onComplete)) {
+        LOG_ERROR("unable to submit async read on file '%s'", path_.c_str());
+        return -1;
+    }
+
+    return 0;
+}
+
+uint64_t File::getLastSegment() {
+    auto size = metadata_->getFileSize();
+    return size > 0 ? (size - 1) / metadata_->getSegmentSize() : 0;
+}
+
+bool File::requestSegments(uint64_t first, uint64_t last,
+                           const ReorderBuffer *buffer) {
+    // Segments of the current read are checked against the buffer; segments
+    // requested by read-ahead against the shared cache
+    auto isKnown = [this, buffer](uint64_t segment) {
+        if (segments_.find(segment) != segments_.end() ||
+            inflight_.find(segment) != inflight_.end()) {
+            return true;
+        }
+
+        if (buffer != nullptr) {
+            return buffer->has(segment);
+        }
+
+        return cache_ != nullptr && cache_->contains(cache_key_, segment);
+    };
+
+    for (auto segment = first; segment <= last;) {
+        if (isKnown(segment)) {
+            ++segment;
+            continue;
+        }
+
+        // Request each run of missing segments as one range
+        auto runFirst = segment;
+        for (; segment <= last && !isKnown(segment); ++segment) {
+            inflight_.insert(segment);
+        }
+
+        if (!consumer_->asyncRequestSegmentRange(
+                metadata_->getVersionedName(), runFirst, segment - 1,
+                *read_id_)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool File::requestSegments(const std::set<uint64_t> &segments) {
+    for (auto it = segments.begin(); it != segments.end();) {
+        if (inflight_.find(*it) != inflight_.end()) {
+            ++it;
+            continue;
+        }
+
+        // Request each run of consecutive segments as one range
+        auto runFirst = *it, runLast = *it;
+        for (; it != segments.end() && *it == runLast &&
+               inflight_.find(*it) == inflight_.end();
+             ++it, ++runLast) {
+            inflight_.insert(*it);
+        }
+
+        if (!consumer_->asyncRequestSegmentRange(
+                metadata_->getVersionedName(), runFirst, runLast - 1,
+                *read_id_)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool File::readAhead(uint64_t last) {
+    auto readAheadSegments = consumer_->getOptions().readAheadSegments;
+    if (readAheadSegments == 0) {
+        return true;
+    }
+
+    auto first = std::max(read_ahead_to_ + 1, last + 1);
+    auto target = std::min(last + readAheadSegments, getLastSegment());
+
+    if (first > target) {
+        return true;
+    }
+
+    read_ahead_to_ = target;
+    return requestSegments(first, target);
 }
 
 bool File::getFileMetadata(const char *path) {
@@ -185,6 +571,15 @@ bool File::getFileMetadata(const char *path) {
         return false;
     }
 
+    auto cache = consumer_->getMetadataCache();
+    if (cache != nullptr && cache->get(path, metadata_)) {
+        if (metadata_ == nullptr) {
+            LOG_DEBUG("file metadata: cached negative answer for '%s'", path);
+            return false;
+        }
+        return true;
+    }
+
     auto interest =
         std::make_shared<ndn::Interest>(rdrDiscoveryNameFileRetrieval(
             std::string(path), consumer_->getNamePrefix()));
@@ -201,10 +596,25 @@ bool File::getFileMetadata(const char *path) {
 
     if (data->getContentType() == ndn::tlv::ContentType_Nack) {
         LOG_ERROR("unable to list file '%s'", path);
+
+        if (cache != nullptr) {
+            cache->putNegative(path);
+        }
         return false;
     }
 
     metadata_ = std::make_shared<FileMetadata>(data->getContent());
+
+    // All reads are laid out in segments of the size chosen by the server
+    if (metadata_->getSegmentSize() == 0) {
+        LOG_ERROR("file metadata: missing segment size for '%s'", path);
+        metadata_ = nullptr;
+        return false;
+    }
+
+    if (cache != nullptr) {
+        cache->put(path, metadata_);
+    }
     return true;
 }
 
@@ -28,15 +28,29 @@
 #ifndef NDNC_LIB_POSIX_FILE_HPP
 #define NDNC_LIB_POSIX_FILE_HPP
 
+#include <chrono>
+#include <map>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "consumer.hpp"
 #include "file-metadata.hpp"
+#include "reorder-buffer.hpp"
 #include "utils/measurements-reporter.hpp"
 
+namespace ndnc::posix {
+struct ReadRange {
+    void *buf;
+    off_t offset;
+    size_t blen;
+};
+}; // namespace ndnc::posix
+
 namespace ndnc::posix {
 class File {
   public:
@@ -47,21 +61,48 @@ class File {
     int close();
     int stat(const char *path, struct stat *buf);
     int fstat(struct stat *buf);
-    ssize_t read(void *buf, off_t offset, size_t blen);
+    int checksum(const char *path, const std::string &algorithm,
+                 std::string &value);
+    ssize_t read(void *buf, off_t offset, size_t blen,
+                 ReorderBuffer::OnProgress onProgress = nullptr);
+    ssize_t readv(const std::vector<ReadRange> &ranges);
+    int readAsync(void *buf, off_t offset, size_t blen,
+                  AsyncReader::OnComplete onComplete);
 
   private:
     bool isOpened();
     bool getFileMetadata(const char *path);
     uint64_t getConsumerId();
 
+    uint64_t getLastSegment();
+    bool requestSegments(uint64_t first, uint64_t last,
+                         const ReorderBuffer *buffer = nullptr);
+    bool requestSegments(const std::set<uint64_t> &segments);
+    bool readAhead(uint64_t last);
+
   private:
     std::shared_ptr<Consumer> consumer_;
     std::shared_ptr<FileMetadata> metadata_;
     std::unique_ptr<ndnc::MeasurementsReporter> reporter_;
     std::string path_;
 
+    std::shared_ptr<SegmentCache> cache_;
+    std::string cache_key_; // wire encoding of the versioned Name
+
     std::unordered_map<std::thread::id, uint64_t> consumer_ids_;
     std::mutex mutex_;
+
+    // Read-ahead state. All content is fetched on a dedicated consumer id and
+    // reads on the same file are serialized
+    std::optional<uint64_t> read_id_;
+    off_t next_offset_;      // expected offset of the next sequential read
+    uint64_t read_ahead_to_; // last segment requested by read-ahead
+    std::map<uint64_t, std::shared_ptr<ndn::Data>> segments_;
+    std::unordered_set<uint64_t> inflight_;
+    std::mutex read_mutex_;
+
+    // How long checksum() polls a producer that is still computing
+    static constexpr std::chrono::seconds checksumMaxWait{600};
 };
 }; // namespace ndnc::posix
 
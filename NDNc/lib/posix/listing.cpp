@@ -0,0 +1,360 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "listing.hpp"
+#include "logger/logger.hpp"
+
+namespace ndnc::posix {
+Listing::Listing(std::shared_ptr<Consumer> consumer)
+    : consumer_{consumer}, cache_{consumer->getMetadataCache()},
+      concurrency_{std::max(consumer->getOptions().metadataConcurrency,
+                            static_cast<size_t>(1))} {
+}
+
+Listing::~Listing() {
+}
+
+std::shared_ptr<ndn::Interest>
+Listing::makeMetadataInterest(const std::string &path, bool dirListing) {
+    auto interest = std::make_shared<ndn::Interest>(
+        dirListing
+            ? rdrDiscoveryNameDirListing(path, consumer_->getNamePrefix())
+            : rdrDiscoveryNameFileRetrieval(path, consumer_->getNamePrefix()));
+    interest->setCanBePrefix(true);
+    interest->setMustBeFresh(true);
+    return interest;
+}
+
+std::shared_ptr<FileMetadata>
+Listing::decodeMetadata(const std::string &path,
+                        const std::shared_ptr<ndn::Data> &data) {
+    if (data == nullptr || !data->hasContent()) {
+        LOG_ERROR("metadata: invalid data for '%s'", path.c_str());
+        return nullptr;
+    }
+
+    if (data->getContentType() == ndn::tlv::ContentType_Nack) {
+        LOG_ERROR("unable to list '%s'", path.c_str());
+        return nullptr;
+    }
+
+    return std::make_shared<FileMetadata>(data->getContent());
+}
+
+std::shared_ptr<FileMetadata> Listing::getMetadata(const std::string &path,
+                                                   uint64_t id,
+                                                   bool dirListing) {
+    std::shared_ptr<FileMetadata> metadata(nullptr);
+
+    // Only FILE RETRIEVAL metadata is cached by path
+    auto cache = dirListing ? nullptr : cache_;
+    if (cache != nullptr && cache->get(path, metadata)) {
+        return metadata;
+    }
+
+    auto data = consumer_->syncRequestDataFor(
+        makeMetadataInterest(path, dirListing), id);
+    metadata = decodeMetadata(path, data);
+
+    // Cache both valid and negative answers, but not failed requests
+    if (cache != nullptr && data != nullptr && data->hasContent()) {
+        cache->put(path, metadata);
+    }
+
+    return metadata;
+}
+
+std::vector<std::shared_ptr<FileMetadata>>
+Listing::getMetadata(const std::vector<std::string> &paths, uint64_t id) {
+    std::vector<std::shared_ptr<FileMetadata>> all(paths.size(), nullptr);
+
+    // Interest Name of each pending request, mapped to the indexes of its
+    // path; a path listed more than once is requested once
+    std::map<ndn::Name, std::vector<size_t>> pending;
+    std::vector<std::shared_ptr<ndn::Data>> pkts(64);
+    size_t next = 0, inflight = 0;
+
+    while ((next < paths.size() || inflight > 0) && consumer_->isValid()) {
+        // Keep up to concurrency_ requests in flight
+        for (; next < paths.size() && inflight < concurrency_; ++next) {
+            if (cache_ != nullptr && cache_->get(paths[next], all[next])) {
+                continue;
+            }
+
+            auto interest = makeMetadataInterest(paths[next], false);
+            auto [it, inserted] = pending.try_emplace(interest->getName());
+            it->second.push_back(next);
+
+            if (!inserted) {
+                continue;
+            }
+
+            if (!consumer_->asyncRequestDataFor(std::move(interest), id)) {
+                return all;
+            }
+            ++inflight;
+        }
+
+        if (inflight == 0) {
+            continue;
+        }
+
+        auto npkts = consumer_->getData(pkts, id);
+
+        for (size_t i = 0; i < npkts; ++i) {
+            --inflight;
+
+            if (pkts[i] == nullptr) {
+                // A request failed; its path is left without metadata
+                LOG_ERROR("metadata: pipeline error");
+                continue;
+            }
+
+            // The Data Name may extend the Interest Name with version and
+            // segment components
+            auto name = pkts[i]->getName();
+            auto it = pending.end();
+            for (size_t k = 0; k <= 2 && k < name.size() && it == pending.end();
+                 ++k) {
+                it = pending.find(name.getPrefix(name.size() - k));
+            }
+
+            if (it == pending.end()) {
+                LOG_DEBUG("metadata: unexpected Data %s",
+                          name.toUri().c_str());
+                ++inflight;
+                continue;
+            }
+
+            auto indexes = std::move(it->second);
+            pending.erase(it);
+
+            auto metadata = decodeMetadata(paths[indexes[0]], pkts[i]);
+            if (cache_ != nullptr && pkts[i]->hasContent()) {
+                cache_->put(paths[indexes[0]], metadata);
+            }
+
+            for (auto index : indexes) {
+                all[index] = metadata;
+            }
+        }
+    }
+
+    return all;
+}
+
+bool Listing::getEntries(const std::shared_ptr<FileMetadata> &metadata,
+                         uint64_t id, std::vector<std::string> &entries) {
+    entries.clear();
+
+    if (metadata == nullptr) {
+        return false;
+    }
+
+    ListingStream stream(consumer_, metadata, id);
+
+    std::string_view entry;
+    int ret;
+    while ((ret = stream.next(entry)) > 0) {
+        entries.emplace_back(entry);
+    }
+
+    return ret == 0;
+}
+}; // namespace ndnc::posix
+
+namespace ndnc::posix {
+ListingStream::ListingStream(std::shared_ptr<Consumer> consumer,
+                             std::shared_ptr<FileMetadata> metadata,
+                             uint64_t id, size_t window)
+    : consumer_{consumer}, name_{metadata->getVersionedName()}, id_{id},
+      window_{std::max(window, static_cast<size_t>(1))},
+      finalBlockId_{std::nullopt}, nextSegment_{0}, nextRequest_{0},
+      segments_{}, current_{nullptr}, pos_{0}, carry_{}, spanned_{},
+      done_{false} {
+    // The first segment carries the FinalBlockId of the listing
+    if (!consumer_->asyncRequestSegmentRange(name_, 0, 0, id_)) {
+        done_ = true;
+    }
+    nextRequest_ = 1;
+}
+
+ListingStream::~ListingStream() {
+}
+
+int ListingStream::next(std::string_view &entry) {
+    while (!done_) {
+        if (current_ != nullptr) {
+            auto content = current_->getContent();
+            auto bytes = reinterpret_cast<const char *>(content.value());
+            auto size = content.value_size();
+
+            while (pos_ < size) {
+                auto end = static_cast<const char *>(
+                    memchr(bytes + pos_, '\0', size - pos_));
+
+                if (end == nullptr) {
+                    // The entry continues in the next segment
+                    carry_.append(bytes + pos_, size - pos_);
+                    pos_ = size;
+                    break;
+                }
+
+                auto len = static_cast<size_t>(end - (bytes + pos_));
+                auto head = bytes + pos_;
+                pos_ += len + 1;
+
+                if (!carry_.empty()) {
+                    spanned_ = std::move(carry_.append(head, len));
+                    carry_.clear();
+                    entry = spanned_;
+                    return 1;
+                }
+
+                // An empty entry ends the listing
+                if (len == 0) {
+                    done_ = true;
+                    return 0;
+                }
+
+                entry = std::string_view(head, len);
+                return 1;
+            }
+
+            current_ = nullptr;
+        }
+
+        if (finalBlockId_.has_value() && nextSegment_ > *finalBlockId_) {
+            done_ = true;
+
+            if (!carry_.empty()) {
+                spanned_ = std::move(carry_);
+                carry_.clear();
+                entry = spanned_;
+                return 1;
+            }
+            return 0;
+        }
+
+        if (auto it = segments_.find(nextSegment_); it != segments_.end()) {
+            current_ = it->second;
+            pos_ = 0;
+            segments_.erase(it);
+            ++nextSegment_;
+
+            if (!requestSegments()) {
+                break;
+            }
+            continue;
+        }
+
+        if (!receive()) {
+            break;
+        }
+    }
+
+    if (!done_) {
+        done_ = true;
+        return -1;
+    }
+    return 0;
+}
+
+bool ListingStream::requestSegments() {
+    if (!finalBlockId_.has_value() || nextRequest_ > *finalBlockId_) {
+        return true;
+    }
+
+    // Top up the window in batches rather than one segment at a time
+    auto last = std::min(*finalBlockId_, nextSegment_ + window_ - 1);
+    if (last < nextRequest_ ||
+        (last - nextRequest_ + 1 < window_ / 4 && last < *finalBlockId_)) {
+        return true;
+    }
+
+    if (!consumer_->asyncRequestSegmentRange(name_, nextRequest_, last, id_)) {
+        LOG_ERROR("read dir contents: unable to request segments");
+        return false;
+    }
+
+    nextRequest_ = last + 1;
+    return true;
+}
+
+bool ListingStream::receive() {
+    std::vector<std::shared_ptr<ndn::Data>> pkts(16);
+
+    size_t npkts = 0;
+    while (npkts == 0) {
+        if (!consumer_->isValid()) {
+            return false;
+        }
+        npkts = consumer_->getData(pkts, id_);
+    }
+
+    for (size_t i = 0; i < npkts; ++i) {
+        auto data = pkts[i];
+
+        if (data == nullptr || !data->hasContent()) {
+            LOG_ERROR("read dir contents: invalid data");
+            return false;
+        }
+
+        if (data->getContentType() == ndn::tlv::ContentType_Nack) {
+            LOG_ERROR("unable to get the contents of dir '%s'",
+                      name_.toUri().c_str());
+            return false;
+        }
+
+        if (!data->getFinalBlock() || !data->getFinalBlock()->isSegment()) {
+            LOG_ERROR("dir list data content FinalBlockId is not a segment");
+            return false;
+        }
+
+        auto name = data->getName();
+        if (!name_.isPrefixOf(name) || !name.at(-1).isSegment()) {
+            LOG_DEBUG("read dir contents: unexpected Data %s",
+                      name.toUri().c_str());
+            continue;
+        }
+
+        if (!finalBlockId_.has_value()) {
+            finalBlockId_ = data->getFinalBlock()->toSegment();
+        }
+
+        auto segment = name.at(-1).toSegment();
+        if (segment >= nextSegment_ && segment <= *finalBlockId_) {
+            segments_.emplace(segment, data);
+        }
+    }
+
+    return requestSegments();
+}
+}; // namespace ndnc::posix
@@ -0,0 +1,151 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_POSIX_LISTING_HPP
+#define NDNC_LIB_POSIX_LISTING_HPP
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "consumer.hpp"
+#include "file-metadata.hpp"
+
+namespace ndnc::posix {
+/**
+ * @brief Incremental parser of a directory listing. Entries are yielded as
+ * soon as the segment holding them arrives, while at most a window of
+ * segments is requested ahead of the one being parsed
+ *
+ */
+class ListingStream {
+  public:
+    ListingStream(std::shared_ptr<Consumer> consumer,
+                  std::shared_ptr<FileMetadata> metadata, uint64_t id,
+                  size_t window = 64);
+    ~ListingStream();
+
+    /**
+     * @brief Get the next entry of the listing. The view points into the
+     * retained Data packet, or into an internal buffer for entries spanning
+     * segment boundaries, and stays valid until the next call
+     *
+     * @param entry The entry name, relative to the directory
+     * @return int 1 on a new entry, 0 at the end of the listing, -1 on error
+     */
+    int next(std::string_view &entry);
+
+  private:
+    bool receive();
+    bool requestSegments();
+
+  private:
+    std::shared_ptr<Consumer> consumer_;
+    ndn::Name name_;
+    uint64_t id_;
+    size_t window_;
+
+    std::optional<uint64_t> finalBlockId_;
+    // The next segment to parse and the next segment to request
+    uint64_t nextSegment_;
+    uint64_t nextRequest_;
+    // Segments received ahead of the one being parsed
+    std::map<uint64_t, std::shared_ptr<ndn::Data>> segments_;
+
+    std::shared_ptr<ndn::Data> current_;
+    size_t pos_;
+    // Head of an entry spanning segment boundaries, and the last such entry
+    std::string carry_;
+    std::string spanned_;
+    bool done_;
+};
+
+/**
+ * @brief Batched directory listing engine. Listing segments are fetched
+ * concurrently once the FinalBlockId is known, and the metadata of many paths
+ * is requested in parallel, bounded by a concurrency limit
+ *
+ */
+class Listing {
+  public:
+    Listing(std::shared_ptr<Consumer> consumer);
+    ~Listing();
+
+    /**
+     * @brief Get the metadata of one path
+     *
+     * @param path The file or directory path
+     * @param id The consumer id
+     * @param dirListing Use the DIRECTORY LISTING discovery Name instead of
+     * the FILE RETRIEVAL one
+     * @return std::shared_ptr<FileMetadata> The metadata or null on failure
+     */
+    std::shared_ptr<FileMetadata> getMetadata(const std::string &path,
+                                              uint64_t id,
+                                              bool dirListing = false);
+
+    /**
+     * @brief Get the metadata of many paths in parallel
+     *
+     * @param paths The file or directory paths
+     * @param id The consumer id
+     * @return std::vector<std::shared_ptr<FileMetadata>> The metadata of each
+     * path, in the same order; null for the paths that failed
+     */
+    std::vector<std::shared_ptr<FileMetadata>>
+    getMetadata(const std::vector<std::string> &paths, uint64_t id);
+
+    /**
+     * @brief Get the entries of a directory listing
+     *
+     * @param metadata The directory metadata
+     * @param id The consumer id
+     * @param entries The entry names, relative to the directory
+     * @return true The listing was retrieved
+     * @return false Unable to retrieve the listing
+     */
+    bool getEntries(const std::shared_ptr<FileMetadata> &metadata, uint64_t id,
+                    std::vector<std::string> &entries);
+
+  private:
+    std::shared_ptr<ndn::Interest> makeMetadataInterest(const std::string &path,
+                                                        bool dirListing);
+
+    std::shared_ptr<FileMetadata>
+    decodeMetadata(const std::string &path,
+                   const std::shared_ptr<ndn::Data> &data);
+
+  private:
+    std::shared_ptr<Consumer> consumer_;
+    std::shared_ptr<MetadataCache> cache_;
+    size_t concurrency_;
+};
+}; // namespace ndnc::posix
+
+#endif // NDNC_LIB_POSIX_LISTING_HPP
@@ -0,0 +1,134 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_POSIX_METADATA_CACHE_HPP
+#define NDNC_LIB_POSIX_METADATA_CACHE_HPP
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "file-metadata.hpp"
+
+namespace ndnc::posix {
+/**
+ * @brief Cache of RDR metadata keyed by path, shared by File, Dir and stat
+ * calls. Entries expire after a fixed TTL. Paths for which the producer
+ * answered with a ContentType_Nack are cached as negative entries
+ *
+ */
+class MetadataCache {
+  private:
+    struct Entry {
+        std::shared_ptr<FileMetadata> metadata; // null for negative entries
+        std::chrono::steady_clock::time_point expiresAt;
+    };
+
+  public:
+    /**
+     * @brief Construct a new Metadata Cache object
+     *
+     * @param ttl The lifetime of each entry
+     * @param capacity The maximum number of entries
+     */
+    MetadataCache(std::chrono::milliseconds ttl, size_t capacity = 65536)
+        : ttl_{ttl}, capacity_{capacity} {
+    }
+
+    ~MetadataCache() {
+    }
+
+    /**
+     * @brief Look up the metadata of a path
+     *
+     * @param path The file or directory path
+     * @param metadata The cached metadata; null for a negative entry
+     * @return true A valid entry was found
+     * @return false No valid entry was found
+     */
+    bool get(const std::string &path, std::shared_ptr<FileMetadata> &metadata) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = entries_.find(path);
+        if (it == entries_.end()) {
+            return false;
+        }
+
+        if (it->second.expiresAt <= std::chrono::steady_clock::now()) {
+            entries_.erase(it);
+            return false;
+        }
+
+        metadata = it->second.metadata;
+        return true;
+    }
+
+    void put(const std::string &path, std::shared_ptr<FileMetadata> metadata) {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (entries_.size() >= capacity_ &&
+            entries_.find(path) == entries_.end()) {
+            purge(now);
+        }
+
+        entries_[path] = Entry{metadata, now + ttl_};
+    }
+
+    void putNegative(const std::string &path) {
+        put(path, nullptr);
+    }
+
+    void erase(const std::string &path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.erase(path);
+    }
+
+  private:
+    void purge(std::chrono::steady_clock::time_point now) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            it = it->second.expiresAt <= now ? entries_.erase(it) : ++it;
+        }
+
+        // Still full of valid entries; make room for the new one
+        if (entries_.size() >= capacity_) {
+            entries_.erase(entries_.begin());
+        }
+    }
+
+  private:
+    std::chrono::milliseconds ttl_;
+    size_t capacity_;
+
+    std::unordered_map<std::string, Entry> entries_;
+    std::mutex mutex_;
+};
+}; // namespace ndnc::posix
+
+#endif // NDNC_LIB_POSIX_METADATA_CACHE_HPP
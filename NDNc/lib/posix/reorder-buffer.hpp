@@ -0,0 +1,186 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_POSIX_REORDER_BUFFER_HPP
+#define NDNC_LIB_POSIX_REORDER_BUFFER_HPP
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <sys/types.h>
+#include <vector>
+
+#include <ndn-cxx/data.hpp>
+
+#include "logger/logger.hpp"
+
+namespace ndnc::posix {
+/**
+ * @brief Reassemble the content of out-of-order Data segments into the
+ * destination buffer of a read call. Each segment is copied at its final
+ * position (segment * segmentSize - offset) as soon as it arrives, and the
+ * length of the contiguous prefix is tracked and signaled while it grows
+ *
+ */
+class ReorderBuffer {
+  public:
+    using OnProgress = std::function<void(size_t bytes)>;
+
+  public:
+    /**
+     * @brief Construct a new Reorder Buffer object
+     *
+     * @param buf The destination buffer
+     * @param offset The file offset of the first byte in buf
+     * @param blen The number of bytes expected in buf
+     * @param segmentSize The segment size of the file
+     * @param onProgress Called with the contiguous prefix length in bytes
+     * every time it grows
+     */
+    ReorderBuffer(void *buf, off_t offset, size_t blen, uint64_t segmentSize,
+                  OnProgress onProgress = nullptr)
+        : buf_{static_cast<uint8_t *>(buf)},
+          offset_{static_cast<uint64_t>(offset)}, blen_{blen},
+          segmentSize_{segmentSize}, onProgress_{onProgress}, contiguous_{0} {
+
+        first_ = offset_ / segmentSize_;
+        last_ = blen_ > 0 ? (offset_ + blen_ - 1) / segmentSize_ : first_;
+        next_ = first_;
+
+        ends_.assign(blen_ > 0 ? last_ - first_ + 1 : 0, -1);
+        pending_ = ends_.size();
+    }
+
+    ~ReorderBuffer() {
+    }
+
+    /**
+     * @brief Copy the content of a Data segment into the destination buffer.
+     * Segments outside the expected range and duplicates are ignored
+     *
+     * @param data The Data packet
+     * @return true The Data packet was accepted or ignored
+     * @return false The Data packet is null or is not a segment
+     */
+    bool insert(const std::shared_ptr<ndn::Data> &data) {
+        if (data == nullptr || !data->getName().at(-1).isSegment()) {
+            return false;
+        }
+
+        auto segment = data->getName().at(-1).toSegment();
+
+        if (segment < first_ || segment > last_ ||
+            ends_[segment - first_] >= 0) {
+            LOG_DEBUG("reorder buffer: unexpected segment=%ld dropped",
+                      segment);
+            return true;
+        }
+
+        auto segmentStart = segment * segmentSize_;
+        auto start = std::max(offset_, segmentStart);
+        auto srcOffset = start - segmentStart;
+        auto dstOffset = start - offset_;
+
+        const auto &content = data->getContent();
+        size_t len = 0;
+
+        if (content.value_size() > srcOffset) {
+            len = std::min(content.value_size() - srcOffset,
+                           blen_ - dstOffset);
+            memcpy(buf_ + dstOffset, content.value() + srcOffset, len);
+        }
+
+        ends_[segment - first_] = dstOffset + len;
+        --pending_;
+
+        advance();
+        return true;
+    }
+
+    bool has(uint64_t segment) const {
+        return segment >= first_ && segment <= last_ &&
+               ends_[segment - first_] >= 0;
+    }
+
+    bool isComplete() const {
+        return pending_ == 0;
+    }
+
+    /**
+     * @brief Get the number of bytes from the beginning of the destination
+     * buffer that have been filled without gaps
+     *
+     */
+    size_t getContiguousBytes() const {
+        return contiguous_;
+    }
+
+    uint64_t getFirstSegment() const {
+        return first_;
+    }
+
+    uint64_t getLastSegment() const {
+        return last_;
+    }
+
+  private:
+    void advance() {
+        auto contiguous = contiguous_;
+
+        for (; next_ <= last_ && ends_[next_ - first_] >= 0; ++next_) {
+            contiguous = ends_[next_ - first_];
+        }
+
+        if (contiguous > contiguous_) {
+            contiguous_ = contiguous;
+
+            if (onProgress_ != nullptr) {
+                onProgress_(contiguous_);
+            }
+        }
+    }
+
+  private:
+    uint8_t *buf_;
+    uint64_t offset_;
+    size_t blen_;
+    uint64_t segmentSize_;
+    OnProgress onProgress_;
+
+    uint64_t first_;
+    uint64_t last_;
+    uint64_t next_;     // first segment not yet received in order
+    size_t pending_;    // number of segments not yet received
+    size_t contiguous_; // length of the contiguous prefix
+
+    // End position in the destination buffer of each received segment; -1
+    // for segments not yet received
+    std::vector<int64_t> ends_;
+};
+}; // namespace ndnc::posix
+
+#endif // NDNC_LIB_POSIX_REORDER_BUFFER_HPP
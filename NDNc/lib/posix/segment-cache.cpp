@@ -0,0 +1,167 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+
+#include "segment-cache.hpp"
+
+namespace ndnc::posix {
+SegmentCache::SegmentCache(size_t capacity, size_t nshards)
+    : hits_{0}, misses_{0}, insertions_{0}, evictions_{0} {
+    nshards = std::max(nshards, static_cast<size_t>(1));
+    shardCapacity_ = capacity / nshards;
+
+    for (size_t i = 0; i < nshards; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+SegmentCache::~SegmentCache() {
+    shards_.clear();
+}
+
+bool SegmentCache::get(const std::string &prefix, uint64_t segment,
+                       std::shared_ptr<ndn::Data> &data) {
+    Key key{prefix, segment};
+    auto &shard = getShard(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        ++misses_;
+        return false;
+    }
+
+    auto &entry = shard.slots[it->second];
+    entry.referenced = true;
+    data = entry.data;
+
+    ++hits_;
+    return true;
+}
+
+bool SegmentCache::contains(const std::string &prefix, uint64_t segment) {
+    Key key{prefix, segment};
+    auto &shard = getShard(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.index.find(key) != shard.index.end();
+}
+
+void SegmentCache::put(const std::string &prefix, uint64_t segment,
+                       const std::shared_ptr<ndn::Data> &data) {
+    if (data == nullptr) {
+        return;
+    }
+
+    Key key{prefix, segment};
+    auto size = data->wireEncode().size();
+
+    if (size > shardCapacity_) {
+        return;
+    }
+
+    auto &shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (auto it = shard.index.find(key); it != shard.index.end()) {
+        shard.slots[it->second].referenced = true;
+        return;
+    }
+
+    evict(shard, size);
+
+    size_t slot;
+    if (!shard.freeSlots.empty()) {
+        slot = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+    } else {
+        slot = shard.slots.size();
+        shard.slots.emplace_back();
+    }
+
+    auto &entry = shard.slots[slot];
+    entry.key = key;
+    entry.data = data;
+    entry.size = size;
+    entry.referenced = false;
+    entry.used = true;
+
+    shard.index.emplace(std::move(key), slot);
+    shard.bytes += size;
+
+    ++insertions_;
+}
+
+SegmentCacheCounters SegmentCache::getCounters() {
+    SegmentCacheCounters counters;
+    counters.hits = hits_;
+    counters.misses = misses_;
+    counters.insertions = insertions_;
+    counters.evictions = evictions_;
+
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        counters.bytes += shard->bytes;
+    }
+
+    return counters;
+}
+
+SegmentCache::Shard &SegmentCache::getShard(const Key &key) {
+    return *shards_[KeyHash{}(key) % shards_.size()];
+}
+
+void SegmentCache::evict(Shard &shard, size_t size) {
+    // CLOCK: sweep the slots, giving a second chance to referenced entries
+    while (shard.bytes + size > shardCapacity_ && !shard.index.empty()) {
+        shard.hand %= shard.slots.size();
+        auto &entry = shard.slots[shard.hand++];
+
+        if (!entry.used) {
+            continue;
+        }
+
+        if (entry.referenced) {
+            entry.referenced = false;
+            continue;
+        }
+
+        shard.index.erase(entry.key);
+        shard.bytes -= entry.size;
+        shard.freeSlots.push_back(shard.hand - 1);
+
+        entry.data = nullptr;
+        entry.key.prefix.clear();
+        entry.size = 0;
+        entry.used = false;
+
+        ++evictions_;
+    }
+}
+}; // namespace ndnc::posix
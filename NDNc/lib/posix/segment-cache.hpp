@@ -0,0 +1,143 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_POSIX_SEGMENT_CACHE_HPP
+#define NDNC_LIB_POSIX_SEGMENT_CACHE_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ndn-cxx/data.hpp>
+
+namespace ndnc::posix {
+struct SegmentCacheCounters {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * @brief Memory bounded cache of Data segments shared by all files opened with
+ * the same Consumer. Entries are keyed by the wire encoding of the versioned
+ * Name and the segment number. The cache is split in shards, each protected by
+ * its own lock and using CLOCK eviction
+ *
+ */
+class SegmentCache {
+  private:
+    struct Key {
+        std::string prefix;
+        uint64_t segment;
+
+        bool operator==(const Key &other) const {
+            return segment == other.segment && prefix == other.prefix;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            return std::hash<std::string>{}(key.prefix) ^
+                   (key.segment * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<ndn::Data> data;
+        size_t size = 0;
+        bool referenced = false;
+        bool used = false;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<Key, size_t, KeyHash> index;
+        std::vector<Entry> slots;
+        std::vector<size_t> freeSlots;
+        size_t hand = 0;
+        size_t bytes = 0;
+    };
+
+  public:
+    /**
+     * @brief Construct a new Segment Cache object
+     *
+     * @param capacity The maximum number of bytes held by the cache
+     * @param nshards The number of shards
+     */
+    SegmentCache(size_t capacity, size_t nshards = 16);
+    ~SegmentCache();
+
+    /**
+     * @brief Look up a segment. Counts a hit or a miss
+     *
+     * @param prefix The wire encoding of the versioned Name
+     * @param segment The segment number
+     * @param data The cached Data packet, if found
+     * @return true The segment was found
+     * @return false The segment was not found
+     */
+    bool get(const std::string &prefix, uint64_t segment,
+             std::shared_ptr<ndn::Data> &data);
+
+    /**
+     * @brief Check if a segment is cached without counting a hit or a miss
+     *
+     */
+    bool contains(const std::string &prefix, uint64_t segment);
+
+    /**
+     * @brief Insert a segment, evicting older entries if needed
+     *
+     */
+    void put(const std::string &prefix, uint64_t segment,
+             const std::shared_ptr<ndn::Data> &data);
+
+    SegmentCacheCounters getCounters();
+
+  private:
+    Shard &getShard(const Key &key);
+    void evict(Shard &shard, size_t size);
+
+  private:
+    size_t shardCapacity_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+    std::atomic<uint64_t> insertions_;
+    std::atomic<uint64_t> evictions_;
+};
+}; // namespace ndnc::posix
+
+#endif // NDNC_LIB_POSIX_SEGMENT_CACHE_HPP
@@ -0,0 +1,154 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <iterator>
+
+#include "xrd-ndn-cks.hpp"
+
+namespace xrdndnofs {
+XrdNdnCks::XrdNdnCks(XrdSysError *erP, XrdNdnOss *oss)
+    : XrdCks(erP), oss_{oss}, default_{algorithms[0]} {
+}
+
+XrdNdnCks::~XrdNdnCks() {
+}
+
+int XrdNdnCks::Calc(const char *Xfn, XrdCksData &Cks, int) {
+    // The producer computes the checksum when it has none for this version
+    auto ret = Get(Xfn, Cks);
+    return ret < 0 ? ret : 0;
+}
+
+int XrdNdnCks::Del(const char *, XrdCksData &) {
+    return -ENOTSUP;
+}
+
+int XrdNdnCks::Get(const char *Xfn, XrdCksData &Cks) {
+    const char *name = Cks.Name[0] != '\0' ? Cks.Name : default_;
+    if (Size(name) <= 0) {
+        return -ENOTSUP;
+    }
+
+    std::string value;
+    if (auto ret = oss_->Checksum(Xfn, name, value); ret < 0) {
+        return ret;
+    }
+
+    // The producer sends the value as 8 hex digits
+    uint32_t csVal = 0;
+    try {
+        csVal = htonl(static_cast<uint32_t>(std::stoul(value, nullptr, 16)));
+    } catch (const std::exception &) {
+        eDest->Emsg("Get", "invalid checksum value for", Xfn);
+        return -EIO;
+    }
+
+    Cks.Set(name);
+    Cks.Set(static_cast<const void *>(&csVal), sizeof(csVal));
+    return Cks.Length;
+}
+
+int XrdNdnCks::Config(const char *, char *) {
+    return 1;
+}
+
+int XrdNdnCks::Init(const char *, const char *DfltCalc) {
+    if (DfltCalc == nullptr) {
+        return 1;
+    }
+
+    for (auto name : algorithms) {
+        if (strcmp(DfltCalc, name) == 0) {
+            default_ = name;
+            return 1;
+        }
+    }
+
+    eDest->Emsg("Init", "unsupported checksum", DfltCalc);
+    return 0;
+}
+
+char *XrdNdnCks::List(const char *Xfn, char *Buff, int Blen, char Sep) {
+    // No checksum is stored on this side for any file
+    if (Xfn != nullptr) {
+        return nullptr;
+    }
+
+    std::string list;
+    for (auto name : algorithms) {
+        list += list.empty() ? name : Sep + std::string(name);
+    }
+
+    if (static_cast<int>(list.size()) >= Blen) {
+        return nullptr;
+    }
+
+    strcpy(Buff, list.c_str());
+    return Buff;
+}
+
+const char *XrdNdnCks::Name(int seqNum) {
+    if (seqNum < 0 || seqNum >= static_cast<int>(std::size(algorithms))) {
+        return nullptr;
+    }
+
+    return algorithms[seqNum];
+}
+
+int XrdNdnCks::Size(const char *Name) {
+    if (Name == nullptr) {
+        Name = default_;
+    }
+
+    for (auto name : algorithms) {
+        if (strcmp(Name, name) == 0) {
+            // Both are 32 bit checksums
+            return sizeof(uint32_t);
+        }
+    }
+
+    return 0;
+}
+
+int XrdNdnCks::Set(const char *, XrdCksData &, int) {
+    return -ENOTSUP;
+}
+
+int XrdNdnCks::Ver(const char *Xfn, XrdCksData &Cks) {
+    XrdCksData current;
+    current.Set(Cks.Name);
+
+    if (auto ret = Get(Xfn, current); ret < 0) {
+        return ret;
+    }
+
+    return current.Length == Cks.Length &&
+           memcmp(current.Value, Cks.Value, Cks.Length) == 0;
+}
+}; // namespace xrdndnofs
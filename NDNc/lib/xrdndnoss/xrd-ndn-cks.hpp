@@ -0,0 +1,69 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_LIB_XRD_NDN_CKS_HPP
+#define NDNC_LIB_XRD_NDN_CKS_HPP
+
+#include <XrdCks/XrdCks.hh>
+#include <XrdCks/XrdCksData.hh>
+
+#include "xrd-ndn-oss.hpp"
+
+namespace xrdndnofs {
+/**
+ * @brief Checksum manager answering XRootD checksum queries with the value
+ * computed by the producer, see ndnc::posix::File::checksum. Nothing is
+ * stored on this side; the producer caches the checksums
+ *
+ */
+class XrdNdnCks : public XrdCks {
+  public:
+    XrdNdnCks(XrdSysError *erP, XrdNdnOss *oss);
+    ~XrdNdnCks();
+
+  public:
+    int Calc(const char *Xfn, XrdCksData &Cks, int doSet = 1) final;
+    int Del(const char *Xfn, XrdCksData &Cks) final;
+    int Get(const char *Xfn, XrdCksData &Cks) final;
+    int Config(const char *Token, char *Line) final;
+    int Init(const char *ConfigFN, const char *DfltCalc = 0) final;
+    char *List(const char *Xfn, char *Buff, int Blen, char Sep = ' ') final;
+    const char *Name(int seqNum = 0) final;
+    int Size(const char *Name = 0) final;
+    int Set(const char *Xfn, XrdCksData &Cks, int myTime = 0) final;
+    int Ver(const char *Xfn, XrdCksData &Cks) final;
+
+  private:
+    // Algorithms served by the producer, the first one is the default
+    static constexpr const char *algorithms[] = {"adler32", "crc32c"};
+
+    XrdNdnOss *oss_;
+    const char *default_;
+};
+}; // namespace xrdndnofs
+
+#endif // NDNC_LIB_XRD_NDN_CKS_HPP
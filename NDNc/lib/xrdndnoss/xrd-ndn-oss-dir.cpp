@@ -28,8 +28,8 @@
 #include "xrd-ndn-oss-dir.hpp"
 
 namespace xrdndnofs {
-XrdNdnOssDir::XrdNdnOssDir(std::shared_ptr<ndnc::posix::Consumer> consumer) {
-    this->dir_ = std::make_shared<ndnc::posix::Dir>(consumer);
+XrdNdnOssDir::XrdNdnOssDir(XrdNdnOss *oss)
+    : oss_{oss}, slot_{std::nullopt}, dir_{nullptr} {
 }
 
 XrdNdnOssDir::~XrdNdnOssDir() {
@@ -37,18 +37,51 @@ XrdNdnOssDir::~XrdNdnOssDir() {
 }
 
 int XrdNdnOssDir::Opendir(const char *path, XrdOucEnv &) {
-    return dir_->open(path);
+    if (slot_.has_value()) {
+        return -EINVAL;
+    }
+
+    slot_ = oss_->acquireConsumer(path);
+    auto consumer = oss_->getConsumer(*slot_);
+
+    if (!consumer->isValid()) {
+        Close(nullptr);
+        return -ENOTCONN;
+    }
+
+    dir_ = std::make_shared<ndnc::posix::Dir>(consumer);
+    auto ret = dir_->open(path);
+
+    if (ret < 0) {
+        Close(nullptr);
+    }
+    return ret;
 }
 
 int XrdNdnOssDir::Readdir(char *buff, int blen) {
+    if (dir_ == nullptr) {
+        return -EBADF;
+    }
+
     return dir_->read(buff, blen);
 }
 
 int XrdNdnOssDir::StatRet(struct stat *buff) {
+    if (dir_ == nullptr) {
+        return -EBADF;
+    }
+
     return dir_->stat(buff);
 }
 
 int XrdNdnOssDir::Close(long long * = 0) {
+    dir_ = nullptr;
+
+    if (slot_.has_value()) {
+        oss_->releaseConsumer(*slot_);
+        slot_ = std::nullopt;
+    }
+
     return 0;
 }
 }; // namespace xrdndnofs
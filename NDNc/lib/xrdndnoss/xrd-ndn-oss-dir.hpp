@@ -28,13 +28,15 @@
 #ifndef NDNC_LIB_XRD_NDN_OSS_DIR_HPP
 #define NDNC_LIB_XRD_NDN_OSS_DIR_HPP
 
+#include <optional>
+
 #include "lib/posix/dir.hpp"
 #include "xrd-ndn-oss.hpp"
 
 namespace xrdndnofs {
 class XrdNdnOssDir : public XrdOssDF {
   public:
-    XrdNdnOssDir(std::shared_ptr<ndnc::posix::Consumer> consumer);
+    XrdNdnOssDir(XrdNdnOss *oss);
     ~XrdNdnOssDir();
 
   public:
@@ -44,6 +46,9 @@ class XrdNdnOssDir : public XrdOssDF {
     int Close(long long *);
 
   private:
+    XrdNdnOss *oss_;
+    // Consumer slot of the opened dir
+    std::optional<size_t> slot_;
     std::shared_ptr<ndnc::posix::Dir> dir_;
 };
 }; // namespace xrdndnofs
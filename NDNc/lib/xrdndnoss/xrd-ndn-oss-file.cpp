@@ -25,11 +25,15 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+
+#include <XrdOuc/XrdOucCRC.hh>
+
 #include "xrd-ndn-oss-file.hpp"
 
 namespace xrdndnofs {
-XrdNdnOssFile::XrdNdnOssFile(std::shared_ptr<ndnc::posix::Consumer> consumer) {
-    this->file_ = std::make_shared<ndnc::posix::File>(consumer);
+XrdNdnOssFile::XrdNdnOssFile(XrdNdnOss *oss)
+    : oss_{oss}, slot_{std::nullopt}, file_{nullptr} {
 }
 
 XrdNdnOssFile::~XrdNdnOssFile() {
@@ -45,11 +49,25 @@ int XrdNdnOssFile::Fstat(struct stat *buf) {
 }
 
 int XrdNdnOssFile::Open(const char *path, int, mode_t, XrdOucEnv &) {
-    if (this->file_ == nullptr) {
+    if (slot_.has_value()) {
         return -EINVAL;
     }
 
-    return file_->open(path);
+    slot_ = oss_->acquireConsumer(path);
+    auto consumer = oss_->getConsumer(*slot_);
+
+    if (!consumer->isValid()) {
+        Close(nullptr);
+        return -ENOTCONN;
+    }
+
+    file_ = std::make_shared<ndnc::posix::File>(consumer);
+    auto ret = file_->open(path);
+
+    if (ret < 0) {
+        Close(nullptr);
+    }
+    return ret;
 }
 
 ssize_t XrdNdnOssFile::Read(off_t, size_t) {
@@ -65,10 +83,98 @@ ssize_t XrdNdnOssFile::Read(void *buff, off_t offset, size_t blen) {
 }
 
 int XrdNdnOssFile::Read(XrdSfsAio *aoip) {
-    aoip->Result = Read((void *)aoip->sfsAio.aio_buf, aoip->sfsAio.aio_offset,
-                        aoip->sfsAio.aio_nbytes);
-    aoip->doneRead();
-    return 0;
+    if (file_ == nullptr) {
+        return -EINVAL;
+    }
+
+    // Return as soon as the segments are enqueued; the aio is completed from
+    // the consumer's completion thread
+    auto ret = file_->readAsync(
+        (void *)aoip->sfsAio.aio_buf, aoip->sfsAio.aio_offset,
+        aoip->sfsAio.aio_nbytes, [aoip](ssize_t result) {
+            aoip->Result = result < 0 ? -EIO : result;
+            aoip->doneRead();
+        });
+
+    return ret < 0 ? -EIO : 0;
+}
+
+ssize_t XrdNdnOssFile::ReadV(XrdOucIOVec *readV, int rdvcnt) {
+    if (file_ == nullptr) {
+        return -EINVAL;
+    }
+
+    // All chunks are fetched as one batch of deduplicated segments
+    std::vector<ndnc::posix::ReadRange> ranges;
+    ranges.reserve(rdvcnt);
+
+    for (int i = 0; i < rdvcnt; ++i) {
+        ranges.push_back({readV[i].data, readV[i].offset,
+                          static_cast<size_t>(readV[i].size)});
+    }
+
+    return file_->readv(ranges);
+}
+
+ssize_t XrdNdnOssFile::pgRead(void *buffer, off_t offset, size_t rdlen,
+                              uint32_t *csvec, uint64_t opts) {
+    if (file_ == nullptr) {
+        return -EINVAL;
+    }
+
+    if (csvec == nullptr) {
+        return file_->read(buffer, offset, rdlen);
+    }
+
+    // Pages are aligned on file offsets; the first one may be shorter
+    auto bytes = static_cast<const uint8_t *>(buffer);
+    size_t pos = 0, inPage = 0, page = 0;
+    uint32_t crc = 0;
+
+    auto checksum = [&](size_t contiguous) {
+        while (pos < contiguous) {
+            auto room = XrdSys::PageSize - (offset + pos) % XrdSys::PageSize;
+            auto len = std::min(contiguous - pos, room);
+
+            crc = XrdOucCRC::Calc32C(bytes + pos, len, crc);
+            pos += len;
+            inPage += len;
+
+            if (len == room) {
+                csvec[page++] = crc;
+                crc = 0;
+                inPage = 0;
+            }
+        }
+    };
+
+    // Checksum the bytes as the contiguous prefix grows, right after they
+    // are copied into the buffer and while they are still hot in cache
+    auto ret = file_->read(buffer, offset, rdlen, checksum);
+    if (ret < 0) {
+        return ret;
+    }
+
+    checksum(ret);
+    if (inPage > 0) {
+        csvec[page++] = crc;
+    }
+
+    // There are no stored checksums; verify the returned pages against the
+    // ones computed while they were being filled in
+    if (opts & XrdOssDF::Verify) {
+        for (size_t i = 0, at = 0; i < page; ++i) {
+            auto room = XrdSys::PageSize - (offset + at) % XrdSys::PageSize;
+            auto len = std::min<size_t>(ret - at, room);
+
+            if (XrdOucCRC::Calc32C(bytes + at, len) != csvec[i]) {
+                return -EDOM;
+            }
+            at += len;
+        }
+    }
+
+    return ret;
 }
 
 ssize_t XrdNdnOssFile::ReadRaw(void *buff, off_t offset, size_t blen) {
@@ -76,11 +182,19 @@ ssize_t XrdNdnOssFile::ReadRaw(void *buff, off_t offset, size_t blen) {
 }
 
 int XrdNdnOssFile::Close(long long * = 0) {
-    if (file_ == nullptr) {
-        return 0;
+    int ret = 0;
+
+    if (file_ != nullptr) {
+        ret = file_->close();
+        file_ = nullptr;
+    }
+
+    if (slot_.has_value()) {
+        oss_->releaseConsumer(*slot_);
+        slot_ = std::nullopt;
     }
 
-    return file_->close();
+    return ret;
 }
 
 int XrdNdnOssFile::Fchmod(mode_t mode) {
@@ -28,6 +28,8 @@
 #ifndef NDNC_LIB_XRD_NDN_OSS_FILE_HPP
 #define NDNC_LIB_XRD_NDN_OSS_FILE_HPP
 
+#include <optional>
+
 #include "lib/posix/file.hpp"
 #include "xrd-ndn-oss.hpp"
 
@@ -36,7 +38,7 @@ class XrdSfsAio;
 namespace xrdndnofs {
 class XrdNdnOssFile : public XrdOssDF {
   public:
-    XrdNdnOssFile(std::shared_ptr<ndnc::posix::Consumer> consumer);
+    XrdNdnOssFile(XrdNdnOss *oss);
     ~XrdNdnOssFile();
 
   public:
@@ -45,6 +47,9 @@ class XrdNdnOssFile : public XrdOssDF {
     ssize_t Read(off_t, size_t);
     ssize_t Read(void *, off_t, size_t);
     int Read(XrdSfsAio *);
+    ssize_t ReadV(XrdOucIOVec *readV, int rdvcnt);
+    ssize_t pgRead(void *buffer, off_t offset, size_t rdlen, uint32_t *csvec,
+                   uint64_t opts);
     ssize_t ReadRaw(void *, off_t, size_t);
     int Close(long long *);
     int Fchmod(mode_t);
@@ -58,6 +63,9 @@ class XrdNdnOssFile : public XrdOssDF {
     int Write(XrdSfsAio *);
 
   private:
+    XrdNdnOss *oss_;
+    // Consumer slot of the opened file
+    std::optional<size_t> slot_;
     std::shared_ptr<ndnc::posix::File> file_;
 };
 }; // namespace xrdndnofs
@@ -31,6 +31,7 @@
 #include <XrdOuc/XrdOucTrace.hh>
 #include <XrdVersion.hh>
 
+#include "xrd-ndn-cks.hpp"
 #include "xrd-ndn-oss-dir.hpp"
 #include "xrd-ndn-oss-file.hpp"
 #include "xrd-ndn-oss-version.hpp"
@@ -97,6 +98,24 @@ XrdOss *XrdOssGetStorageSystem(XrdOss *, XrdSysLogger *Logger,
         "       ofs NDNc consumer. pipelineSize=",
         std::to_string(XrdNdnOfs.options_.pipelineSize).c_str());
 
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. readAhead=",
+        std::to_string(XrdNdnOfs.options_.readAheadSegments).c_str());
+
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. segmentCache=",
+        std::to_string(XrdNdnOfs.options_.segmentCacheSize).c_str());
+
+    XrdNdnOfs.eDest_->Say(
+        "       ofs NDNc consumer. metadataCacheTTL=",
+        std::to_string(XrdNdnOfs.options_.metadataCacheTTL.count()).c_str());
+
+    XrdNdnOfs.eDest_->Say("       ofs NDNc consumer. consumers=",
+                          std::to_string(XrdNdnOfs.nconsumers_).c_str());
+
+    XrdNdnOfs.eDest_->Say("       ofs NDNc consumer. consumerPolicy=",
+                          XrdNdnOfs.hashPolicy_ ? "hash" : "leastLoaded");
+
     XrdNdnOfs.eDest_->Say("       ofs NDNc consumer. influxdb url=",
                           XrdNdnOfs.options_.influxdb.c_str());
 
@@ -107,10 +126,17 @@ XrdOss *XrdOssGetStorageSystem(XrdOss *, XrdSysLogger *Logger,
 
     return ((XrdOss *)&XrdNdnOfs);
 }
+
+// Get the checksum manager, loaded with: ofs.ckslib * libXrdNdnOss.so
+XrdCks *XrdCksInit(XrdSysError *eDest, const char *, const char *) {
+    return new XrdNdnCks(eDest, &XrdNdnOfs);
+}
 }
 
 namespace xrdndnofs {
-XrdNdnOss::XrdNdnOss() : XrdOss(), options_{}, consumer_{nullptr} {
+XrdNdnOss::XrdNdnOss()
+    : XrdOss(), options_{}, nconsumers_{1}, hashPolicy_{false}, consumers_{},
+      openHandles_{} {
 }
 
 XrdNdnOss::~XrdNdnOss() {
@@ -118,8 +144,17 @@ XrdNdnOss::~XrdNdnOss() {
         eDest_->Say("dtor: XrdNdnOss");
     }
 
-    if (consumer_ != nullptr) {
-        consumer_->stop();
+    // The segment cache is shared by all consumers in the pool
+    if (!consumers_.empty() && eDest_ != nullptr &&
+        consumers_.front()->getSegmentCache() != nullptr) {
+        auto counters = consumers_.front()->getSegmentCache()->getCounters();
+        eDest_->Say("segment cache: hits=",
+                    std::to_string(counters.hits).c_str(),
+                    " misses=", std::to_string(counters.misses).c_str());
+    }
+
+    for (auto &consumer : consumers_) {
+        consumer->stop();
     }
 }
 
@@ -155,22 +190,67 @@ int XrdNdnOss::Emsg(const char *pfx, XrdOucErrInfo &einfo, int ecode,
     return -1;
 }
 
-XrdOssDF *XrdNdnOss::newDir(const char *) {
-    if (!this->consumer_->isValid()) {
-        Emsg("newDir", XrdNdnOfs.error_, -1, "invalid consumer");
-        return nullptr;
+size_t XrdNdnOss::pickConsumer(const char *path) {
+    if (consumers_.size() == 1) {
+        return 0;
+    }
+
+    // Reads of the same file share one pipeline, whichever client they
+    // come from
+    if (hashPolicy_ && path != nullptr) {
+        auto i = std::hash<std::string>{}(path) % consumers_.size();
+        if (consumers_[i]->isValid()) {
+            return i;
+        }
     }
 
-    return (XrdNdnOssDir *)new XrdNdnOssDir(this->consumer_);
+    size_t slot = consumers_.size();
+    for (size_t i = 0; i < consumers_.size(); ++i) {
+        if (consumers_[i]->isValid() &&
+            (slot == consumers_.size() ||
+             openHandles_[i].load() < openHandles_[slot].load())) {
+            slot = i;
+        }
+    }
+
+    return slot < consumers_.size() ? slot : 0;
 }
 
-XrdOssDF *XrdNdnOss::newFile(const char *) {
-    if (!this->consumer_->isValid()) {
-        Emsg("newFile", XrdNdnOfs.error_, -1, "invalid consumer");
-        return nullptr;
+size_t XrdNdnOss::acquireConsumer(const char *path) {
+    auto slot = pickConsumer(path);
+    ++openHandles_[slot];
+    return slot;
+}
+
+void XrdNdnOss::releaseConsumer(size_t slot) {
+    --openHandles_[slot];
+}
+
+std::shared_ptr<ndnc::posix::Consumer> XrdNdnOss::getConsumer(size_t slot) {
+    return consumers_[slot];
+}
+
+int XrdNdnOss::Checksum(const char *path, const std::string &algorithm,
+                        std::string &value) {
+    if (consumers_.empty()) {
+        return -ENOTCONN;
     }
 
-    return (XrdNdnOssFile *)new XrdNdnOssFile(this->consumer_);
+    auto file = std::make_shared<ndnc::posix::File>(
+        getConsumer(pickConsumer(path)));
+    auto ret = file->checksum(path, algorithm, value);
+
+    return ret == -1 ? -EIO : ret;
+}
+
+XrdOssDF *XrdNdnOss::newDir(const char *) {
+    // The consumer is picked at Opendir(), once the path is known
+    return (XrdNdnOssDir *)new XrdNdnOssDir(this);
+}
+
+XrdOssDF *XrdNdnOss::newFile(const char *) {
+    // The consumer is picked at Open(), once the path is known
+    return (XrdNdnOssFile *)new XrdNdnOssFile(this);
 }
 
 int XrdNdnOss::Chmod(const char *, mode_t, XrdOucEnv *) {
@@ -190,13 +270,29 @@ int XrdNdnOss::Init(XrdSysLogger *lp, const char *) {
     eDest_->Say("Named Data Networking storage system v",
                 XRDNDNOSS_VERSION_STRING, " initialization.");
 
-    if (consumer_ == nullptr) {
-        consumer_ = std::make_shared<ndnc::posix::Consumer>(options_);
+    if (openHandles_.size() != nconsumers_) {
+        openHandles_ = std::vector<std::atomic<size_t>>(nconsumers_);
     }
 
-    if (consumer_ == nullptr || !consumer_->isValid()) {
-        Emsg("Init", XrdNdnOfs.error_, -1, "init consumer");
-        return -1;
+    for (size_t i = consumers_.size(); i < nconsumers_; ++i) {
+        auto options = options_;
+        if (nconsumers_ > 1) {
+            options.name += "-" + std::to_string(i);
+        }
+
+        // All consumers share the caches of the first one
+        auto consumer =
+            i == 0 ? std::make_shared<ndnc::posix::Consumer>(options)
+                   : std::make_shared<ndnc::posix::Consumer>(
+                         options, consumers_.front()->getSegmentCache(),
+                         consumers_.front()->getMetadataCache());
+
+        if (consumer == nullptr || !consumer->isValid()) {
+            Emsg("Init", XrdNdnOfs.error_, -1, "init consumer");
+            return -1;
+        }
+
+        consumers_.push_back(consumer);
     }
 
     return XrdOssOK;
@@ -216,7 +312,8 @@ int XrdNdnOss::Rename(const char *, const char *, XrdOucEnv *, XrdOucEnv *) {
 
 int XrdNdnOss::Stat(const char *path, struct stat *buff, int = 0,
                     XrdOucEnv * = 0) {
-    auto file = std::make_shared<ndnc::posix::File>(this->consumer_);
+    auto file = std::make_shared<ndnc::posix::File>(
+        getConsumer(pickConsumer(path)));
     return file->stat(path, buff);
 }
 
@@ -358,6 +455,76 @@ bool XrdNdnOss::Config(const char *parms) {
         }
     }
 
+    {
+        int readAhead = 0;
+        if (getIntFromParams("readAhead", readAhead)) {
+            if (readAhead < 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid readAhead value. this argument will be "
+                     "ignored");
+            } else {
+                options_.readAheadSegments = readAhead;
+            }
+        }
+    }
+
+    {
+        int segmentCache = 0;
+        if (getIntFromParams("segmentCache", segmentCache)) {
+            if (segmentCache < 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid segmentCache value. this argument will be "
+                     "ignored");
+            } else {
+                // The value is given in MiB
+                options_.segmentCacheSize =
+                    static_cast<size_t>(segmentCache) * 1024 * 1024;
+            }
+        }
+    }
+
+    {
+        int metadataCacheTTL = 0;
+        if (getIntFromParams("metadataCacheTTL", metadataCacheTTL)) {
+            if (metadataCacheTTL < 0) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid metadataCacheTTL value. this argument will be "
+                     "ignored");
+            } else {
+                options_.metadataCacheTTL =
+                    ndn::time::milliseconds{metadataCacheTTL};
+            }
+        }
+    }
+
+    {
+        int consumers = 0;
+        if (getIntFromParams("consumers", consumers)) {
+            if (consumers < 1) {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid consumers value. this argument will be "
+                     "ignored");
+            } else {
+                nconsumers_ = consumers;
+            }
+        }
+    }
+
+    {
+        std::string consumerPolicy = "";
+        if (getStringFromParams("consumerPolicy", consumerPolicy)) {
+            if (consumerPolicy.compare("hash") == 0) {
+                hashPolicy_ = true;
+            } else if (consumerPolicy.compare("leastLoaded") == 0) {
+                hashPolicy_ = false;
+            } else {
+                Emsg("Config", XrdNdnOfs.error_, -1,
+                     "invalid consumerPolicy value. this argument will be "
+                     "ignored");
+            }
+        }
+    }
+
     {
         std::string influxdb = "";
         if (getStringFromParams("influxdb", influxdb)) {
@@ -370,3 +537,4 @@ bool XrdNdnOss::Config(const char *parms) {
 }; // namespace xrdndnofs
 
 XrdVERSIONINFO(XrdOssGetStorageSystem, "xrdndnoss")
+XrdVERSIONINFO(XrdCksInit, "xrdndncks")
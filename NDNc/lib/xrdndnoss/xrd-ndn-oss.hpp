@@ -28,12 +28,15 @@
 #ifndef NDNC_LIB_XRD_NDN_OSS_HPP
 #define NDNC_LIB_XRD_NDN_OSS_HPP
 
+#include <atomic>
+
 #include <XrdOss/XrdOss.hh>
 #include <XrdOuc/XrdOucErrInfo.hh>
 #include <XrdOuc/XrdOucStream.hh>
 #include <XrdSfs/XrdSfsAio.hh>
 #include <XrdSys/XrdSysError.hh>
 #include <XrdSys/XrdSysLogger.hh>
+#include <XrdSys/XrdSysPageSize.hh>
 #include <XrdSys/XrdSysPlugin.hh>
 
 #include "lib/posix/consumer.hpp"
@@ -82,9 +85,42 @@ class XrdNdnOss : public XrdOss {
     XrdSysError *eDest_;
 
     struct ndnc::posix::ConsumerOptions options_;
+    // Number of consumers, each with its own face and pipeline thread
+    size_t nconsumers_;
+    // Assign files to consumers by hash of their path instead of to the
+    // consumer with the fewest open handles
+    bool hashPolicy_;
+
+  public:
+    /**
+     * @brief Get the checksum of a file, computed by the producer
+     *
+     * @param path The file path
+     * @param algorithm The checksum algorithm, adler32 or crc32c
+     * @param value The checksum value in hex digits
+     * @return int 0 on success or -errno
+     */
+    int Checksum(const char *path, const std::string &algorithm,
+                 std::string &value);
+
+    /**
+     * @brief Pick the consumer of a file or dir being opened and count one
+     * more open handle on it
+     *
+     * @param path The path being opened
+     * @return size_t The consumer slot, passed on to releaseConsumer()
+     */
+    size_t acquireConsumer(const char *path);
+    void releaseConsumer(size_t slot);
+    std::shared_ptr<ndnc::posix::Consumer> getConsumer(size_t slot);
+
+  private:
+    size_t pickConsumer(const char *path);
 
   private:
-    std::shared_ptr<ndnc::posix::Consumer> consumer_;
+    std::vector<std::shared_ptr<ndnc::posix::Consumer>> consumers_;
+    // Number of open files and dirs by consumer slot
+    std::vector<std::atomic<size_t>> openHandles_;
 };
 }; // namespace xrdndnofs
 
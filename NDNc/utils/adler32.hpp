@@ -0,0 +1,70 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_UTILS_ADLER32_HPP
+#define NDNC_UTILS_ADLER32_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace ndnc {
+/**
+ * @brief Extend an Adler-32 checksum over a buffer. Start from 1 for the
+ * checksum of new data, as with zlib's adler32 and xrdadler32
+ *
+ * @param adler The checksum of the preceding bytes, or 1
+ * @param buf The buffer
+ * @param len The buffer length in bytes
+ * @return uint32_t The checksum including the buffer
+ */
+inline uint32_t adler32(uint32_t adler, const void *buf, size_t len) {
+    static const uint32_t base = 65521;
+    // Largest n such that 255n(n+1)/2 + (n+1)(base-1) fits in 32 bits
+    static const size_t nmax = 5552;
+
+    auto p = static_cast<const uint8_t *>(buf);
+    uint32_t a = adler & 0xFFFF, b = adler >> 16;
+
+    while (len > 0) {
+        auto n = std::min(len, nmax);
+        len -= n;
+
+        for (; n > 0; --n) {
+            a += *p++;
+            b += a;
+        }
+
+        a %= base;
+        b %= base;
+    }
+
+    return (b << 16) | a;
+}
+}; // namespace ndnc
+
+#endif // NDNC_UTILS_ADLER32_HPP
@@ -0,0 +1,108 @@
+/*
+ * N-DISE: NDN for Data Intensive Science Experiments
+ * Author: Catalin Iordache <catalin.iordache@cern.ch>
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 California Institute of Technology
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NDNC_UTILS_CRC32C_HPP
+#define NDNC_UTILS_CRC32C_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+namespace ndnc {
+namespace detail {
+inline const std::array<uint32_t, 256> &crc32cTable() {
+    static const auto table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c >> 1) ^ (0x82F63B78 & (0 - (c & 1)));
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+inline uint32_t crc32cSoftware(uint32_t c, const uint8_t *p, size_t len) {
+    const auto &table = crc32cTable();
+    for (; len > 0; --len) {
+        c = table[(c ^ *p++) & 0xFF] ^ (c >> 8);
+    }
+    return c;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) inline uint32_t
+crc32cHardware(uint32_t c, const uint8_t *p, size_t len) {
+    uint64_t c64 = c;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        c64 = _mm_crc32_u64(c64, v);
+    }
+
+    c = static_cast<uint32_t>(c64);
+    for (; len > 0; --len) {
+        c = _mm_crc32_u8(c, *p++);
+    }
+    return c;
+}
+#endif
+}; // namespace detail
+
+/**
+ * @brief Extend a CRC32C (Castagnoli) checksum over a buffer, using the SSE4.2
+ * crc32 instruction when the CPU supports it. Starting from 0, the result
+ * matches the standard CRC32C of the data and can be extended piecewise
+ *
+ * @param crc The checksum of the preceding bytes, or 0
+ * @param buf The buffer
+ * @param len The buffer length in bytes
+ * @return uint32_t The checksum including the buffer
+ */
+inline uint32_t crc32c(uint32_t crc, const void *buf, size_t len) {
+    auto p = static_cast<const uint8_t *>(buf);
+
+#if defined(__x86_64__)
+    static const bool hasSse42 = __builtin_cpu_supports("sse4.2");
+    if (hasSse42) {
+        return ~detail::crc32cHardware(~crc, p, len);
+    }
+#endif
+
+    return ~detail::crc32cSoftware(~crc, p, len);
+}
+}; // namespace ndnc
+
+#endif // NDNC_UTILS_CRC32C_HPP
@@ -12,6 +12,11 @@ LDFLAGSLOCAL='-L'${PWD}'/libs'
 LDFLAGS=$LDFLAGSLOCAL" -L${GOPATH}/src/github.com/usnistgov/ndn-dpdk/build -lndn-dpdk-c -lurcu-qsbr -lurcu-cds -lubpf -lspdk -lspdk_env_dpdk -lrte_bus_pci -lrte_bus_vdev -lrte_pmd_ring -lnuma -lm -lcommon"
 LIB_FILESYSTEM=$LDFLAGSLOCAL' -lfilesystem -lstdc++ -lhdfs -ljvm'
 
+if pkg-config --exists liburing; then
+  CXXFLAGS=$CXXFLAGS' -DFILESYSTEM_IO_URING'
+  LIB_FILESYSTEM=$LIB_FILESYSTEM' '$(pkg-config --libs liburing)
+fi
+
 if [[ -n $RELEASE ]]; then
   CFLAGS=$CFLAGS' -DNDEBUG -DZF_LOG_DEF_LEVEL=ZF_LOG_INFO'
   CXXFLAGS=$CXXFLAGS' -DNDEBUG -DZF_LOG_DEF_LEVEL=ZF_LOG_INFO'
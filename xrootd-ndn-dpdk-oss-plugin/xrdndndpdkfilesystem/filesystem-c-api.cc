@@ -71,3 +71,11 @@ int libfs_read(void *obj, const char *pathname, void *buf, size_t count,
                off_t offset) {
     return asFilesystem(obj)->read(pathname, buf, count, offset);
 }
+
+int libfs_readBatch(void *obj, FileSystemRead *reqs, uint16_t n) {
+    return asFilesystem(obj)->readBatch(reqs, n);
+}
+
+int libfs_setDirectIO(void *obj, int enable) {
+    return asFilesystem(obj)->setDirectIO(enable != 0);
+}
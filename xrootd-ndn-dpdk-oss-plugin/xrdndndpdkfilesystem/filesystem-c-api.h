@@ -24,10 +24,24 @@
 #define XRDNDNDPDK_FILESYSTEM_C_API_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/types.h>
 
 typedef enum { FT_POSIX = 0, FT_HDFS, FT_CEPHFS } FilesystemType;
 
+/**
+ * @brief One read request of a batch. On return result holds the number of
+ * bytes read into buf or -errno
+ *
+ */
+typedef struct FileSystemRead {
+    const char *pathname;
+    void *buf;
+    size_t count;
+    off_t offset;
+    int result;
+} FileSystemRead;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,6 +53,8 @@ int libfs_open(void *obj, const char *pathname);
 int libfs_fstat(void *obj, const char *pathname, void *buf);
 int libfs_read(void *obj, const char *pathname, void *buf, size_t count,
                off_t offset);
+int libfs_readBatch(void *obj, FileSystemRead *reqs, uint16_t n);
+int libfs_setDirectIO(void *obj, int enable);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -41,4 +41,22 @@
  */
 #define FILESYSTEM_EFAILURE 1
 
+/**
+ * @brief io_uring submission queue depth. Matches the maximum RX burst size
+ *
+ */
+#define FILESYSTEM_URING_DEPTH 64
+
+/**
+ * @brief Offset, length and buffer alignment required by O_DIRECT
+ *
+ */
+#define FILESYSTEM_DIRECT_ALIGN 4096
+
+/**
+ * @brief Size of each registered O_DIRECT bounce buffer
+ *
+ */
+#define FILESYSTEM_DIRECT_BUFFER_SIZE 16384
+
 #endif // XRDNDNDPDK_FILESYSTEM_NAMESPACE_HH
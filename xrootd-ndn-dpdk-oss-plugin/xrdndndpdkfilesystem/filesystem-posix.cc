@@ -18,13 +18,20 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.     *
  *****************************************************************************/
 
+#include <algorithm>
+
 #include "filesystem-posix.hh"
 
 INIT_ZF_LOG(Xrdndndpdkfilesystem);
 
 FileSystemPosix::FileSystemPosix() {}
 
-FileSystemPosix::~FileSystemPosix() {}
+FileSystemPosix::~FileSystemPosix() {
+#ifdef FILESYSTEM_IO_URING
+    std::lock_guard<std::mutex> lock(m_ringMtx);
+    this->teardownRing();
+#endif
+}
 
 int FileSystemPosix::open(const char *pathname) {
     ZF_LOGI("Open file: %s", pathname);
@@ -33,7 +40,7 @@ int FileSystemPosix::open(const char *pathname) {
         return FILESYSTEM_ESUCCESS;
     }
 
-    int fd = ::open(pathname, O_RDONLY);
+    int fd = ::open(pathname, m_directIO ? O_RDONLY | O_DIRECT : O_RDONLY);
     if (fd == -1) {
         ZF_LOGW("Opening file: %s with errcode: %d (%s)", pathname, errno,
                 strerror(errno));
@@ -67,23 +74,43 @@ int FileSystemPosix::fstat(const char *pathname, void *buf) {
     return FILESYSTEM_ESUCCESS;
 }
 
-int FileSystemPosix::read(const char *pathname, void *buf, size_t count,
-                          off_t offset) {
-    ZF_LOGD("Read %zuB @%ld from file: %s", count, offset, pathname);
-
+int FileSystemPosix::getFd(const char *pathname) {
     auto fd = this->getFileHandler(pathname);
     if (unlikely(!fd.has_value())) {
         ZF_LOGI("File descriptor for: %s not available. Opening file",
                 pathname);
 
         if (unlikely(this->open(pathname) != 0)) {
-            return -(FILESYSTEM_EFAILURE);
-        } else {
-            fd = this->getFileHandler(pathname);
+            return -1;
+        }
+
+        fd = this->getFileHandler(pathname);
+        if (unlikely(!fd.has_value())) {
+            return -1;
         }
     }
 
-    int ret = pread(std::any_cast<int>(fd), buf, count, offset);
+    return std::any_cast<int>(fd);
+}
+
+int FileSystemPosix::read(const char *pathname, void *buf, size_t count,
+                          off_t offset) {
+    ZF_LOGD("Read %zuB @%ld from file: %s", count, offset, pathname);
+
+    if (m_directIO) {
+        // O_DIRECT descriptors only accept aligned reads, which go through the
+        // registered bounce buffers of the batch path
+        FileSystemRead req = {pathname, buf, count, offset, 0};
+        this->readBatch(&req, 1);
+        return req.result;
+    }
+
+    int fd = this->getFd(pathname);
+    if (unlikely(fd < 0)) {
+        return -(FILESYSTEM_EFAILURE);
+    }
+
+    int ret = pread(fd, buf, count, offset);
     if (unlikely(ret == -1)) {
         ZF_LOGW("Reading %zuB @%ld from file: %s failed with errcode: %d (%s)",
                 count, offset, pathname, errno, strerror(errno));
@@ -92,3 +119,198 @@ int FileSystemPosix::read(const char *pathname, void *buf, size_t count,
 
     return ret;
 }
+
+int FileSystemPosix::readBatch(FileSystemRead *reqs, uint16_t n) {
+#ifdef FILESYSTEM_IO_URING
+    std::lock_guard<std::mutex> lock(m_ringMtx);
+    if (likely(m_ringReady || this->setupRing() == FILESYSTEM_ESUCCESS)) {
+        int ok = 0;
+        for (uint16_t i = 0; i < n; i += FILESYSTEM_URING_DEPTH) {
+            ok += this->submitBatch(
+                &reqs[i], std::min<uint16_t>(n - i, FILESYSTEM_URING_DEPTH));
+        }
+        return ok;
+    }
+
+    if (m_directIO) {
+        for (uint16_t i = 0; i < n; ++i) {
+            reqs[i].result = -(FILESYSTEM_EFAILURE);
+        }
+        return 0;
+    }
+#endif
+
+    return FileSystem::readBatch(reqs, n);
+}
+
+int FileSystemPosix::setDirectIO(bool enable) {
+#ifdef FILESYSTEM_IO_URING
+    ZF_LOGI("%s direct I/O", enable ? "Enable" : "Disable");
+
+    std::lock_guard<std::mutex> lock(m_ringMtx);
+    this->teardownRing();
+    m_directIO = enable;
+
+    if (enable && this->setupRing() != FILESYSTEM_ESUCCESS) {
+        m_directIO = false;
+        return FILESYSTEM_EFAILURE;
+    }
+    return FILESYSTEM_ESUCCESS;
+#else
+    return FileSystem::setDirectIO(enable);
+#endif
+}
+
+#ifdef FILESYSTEM_IO_URING
+int FileSystemPosix::setupRing() {
+    int ret = io_uring_queue_init(FILESYSTEM_URING_DEPTH, &m_ring, 0);
+    if (ret < 0) {
+        ZF_LOGW("io_uring setup failed with errcode: %d (%s)", -ret,
+                strerror(-ret));
+        return FILESYSTEM_EFAILURE;
+    }
+
+    if (m_directIO) {
+        struct iovec iov[FILESYSTEM_URING_DEPTH];
+        for (int i = 0; i < FILESYSTEM_URING_DEPTH; ++i) {
+            void *buf = nullptr;
+            if (posix_memalign(&buf, FILESYSTEM_DIRECT_ALIGN,
+                               FILESYSTEM_DIRECT_BUFFER_SIZE) != 0) {
+                ZF_LOGF("Not enough memory to alloc direct I/O buffers");
+                m_ringReady = true;
+                this->teardownRing();
+                return FILESYSTEM_EFAILURE;
+            }
+            m_directBuffers.push_back(buf);
+            iov[i] = {buf, FILESYSTEM_DIRECT_BUFFER_SIZE};
+        }
+
+        ret = io_uring_register_buffers(&m_ring, iov, FILESYSTEM_URING_DEPTH);
+        if (ret < 0) {
+            ZF_LOGW("Registering direct I/O buffers failed with errcode: %d "
+                    "(%s)",
+                    -ret, strerror(-ret));
+            m_ringReady = true;
+            this->teardownRing();
+            return FILESYSTEM_EFAILURE;
+        }
+    }
+
+    m_ringReady = true;
+    return FILESYSTEM_ESUCCESS;
+}
+
+void FileSystemPosix::teardownRing() {
+    if (m_ringReady) {
+        io_uring_queue_exit(&m_ring);
+        m_ringReady = false;
+    }
+
+    for (auto buf : m_directBuffers) {
+        free(buf);
+    }
+    m_directBuffers.clear();
+}
+
+int FileSystemPosix::submitBatch(FileSystemRead *reqs, uint16_t n) {
+    unsigned queued = 0;
+
+    for (uint16_t i = 0; i < n; ++i) {
+        FileSystemRead *req = &reqs[i];
+
+        int fd = this->getFd(req->pathname);
+        if (unlikely(fd < 0)) {
+            req->result = -(FILESYSTEM_EFAILURE);
+            continue;
+        }
+
+        // Validate before claiming an SQE, a claimed one is always submitted
+        off_t start = req->offset & ~(off_t)(FILESYSTEM_DIRECT_ALIGN - 1);
+        size_t span = (req->offset - start + req->count +
+                       FILESYSTEM_DIRECT_ALIGN - 1) &
+                      ~(size_t)(FILESYSTEM_DIRECT_ALIGN - 1);
+        if (m_directIO && unlikely(span > FILESYSTEM_DIRECT_BUFFER_SIZE)) {
+            ZF_LOGW("Direct read of %zuB exceeds bounce buffer size",
+                    req->count);
+            req->result = -EINVAL;
+            continue;
+        }
+
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&m_ring);
+        if (unlikely(sqe == NULL)) {
+            ZF_LOGW("io_uring submission queue full");
+            req->result = -EAGAIN;
+            continue;
+        }
+
+        if (m_directIO) {
+            io_uring_prep_read_fixed(sqe, fd, m_directBuffers[i], span, start,
+                                     i);
+        } else {
+            io_uring_prep_read(sqe, fd, req->buf, req->count, req->offset);
+        }
+        io_uring_sqe_set_data(sqe, (void *)(uintptr_t)i);
+
+        req->result = -EINPROGRESS;
+        ++queued;
+    }
+
+    if (queued == 0) {
+        return 0;
+    }
+
+    int ret;
+    do {
+        ret = io_uring_submit(&m_ring);
+    } while (ret == -EINTR || ret == -EAGAIN);
+
+    int ok = 0;
+    for (unsigned done = 0; ret >= 0 && done < queued; ++done) {
+        struct io_uring_cqe *cqe;
+        do {
+            ret = io_uring_wait_cqe(&m_ring, &cqe);
+        } while (ret == -EINTR);
+
+        if (ret == 0) {
+            uint16_t i = (uint16_t)(uintptr_t)io_uring_cqe_get_data(cqe);
+            this->completeRead(&reqs[i], i, cqe->res);
+            ok += (int)(reqs[i].result >= 0);
+            io_uring_cqe_seen(&m_ring, cqe);
+        }
+    }
+
+    if (unlikely(ret < 0)) {
+        // Entries may still be owned by the kernel, start over with a new ring
+        ZF_LOGW("io_uring batch failed with errcode: %d (%s)", -ret,
+                strerror(-ret));
+        this->teardownRing();
+        for (uint16_t i = 0; i < n; ++i) {
+            if (reqs[i].result == -EINPROGRESS) {
+                reqs[i].result = -EIO;
+            }
+        }
+    }
+
+    return ok;
+}
+
+void FileSystemPosix::completeRead(FileSystemRead *req, uint16_t index,
+                                   int res) {
+    if (unlikely(res < 0)) {
+        ZF_LOGW("Reading %zuB @%ld from file: %s failed with errcode: %d (%s)",
+                req->count, req->offset, req->pathname, -res, strerror(-res));
+        req->result = res;
+        return;
+    }
+
+    if (m_directIO) {
+        size_t head = req->offset & (FILESYSTEM_DIRECT_ALIGN - 1);
+        size_t len =
+            (size_t)res > head ? std::min((size_t)res - head, req->count) : 0;
+        memcpy(req->buf, (uint8_t *)m_directBuffers[index] + head, len);
+        res = (int)len;
+    }
+
+    req->result = res;
+}
+#endif
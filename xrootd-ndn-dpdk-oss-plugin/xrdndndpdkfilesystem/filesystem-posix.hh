@@ -28,6 +28,11 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#ifdef FILESYSTEM_IO_URING
+#include <liburing.h>
+#include <vector>
+#endif
+
 #include "filesystem.hh"
 
 class FileSystemPosix : public FileSystem {
@@ -40,6 +45,34 @@ class FileSystemPosix : public FileSystem {
     int read(const char *pathname, void *buf, size_t count = 0,
              off_t offset = 0);
     void close(const char *pathname, std::any fd);
+
+    /**
+     * @brief Read a batch of requests. With io_uring all reads are submitted
+     * at once and reaped as they complete
+     *
+     */
+    int readBatch(FileSystemRead *reqs, uint16_t n);
+    int setDirectIO(bool enable);
+
+  private:
+    int getFd(const char *pathname);
+
+#ifdef FILESYSTEM_IO_URING
+    int setupRing();
+    void teardownRing();
+    int submitBatch(FileSystemRead *reqs, uint16_t n);
+    void completeRead(FileSystemRead *req, uint16_t index, int res);
+#endif
+
+  private:
+    bool m_directIO = false;
+
+#ifdef FILESYSTEM_IO_URING
+    struct io_uring m_ring;
+    bool m_ringReady = false;
+    std::vector<void *> m_directBuffers;
+    std::mutex m_ringMtx;
+#endif
 };
 
 #endif // XRDNDNDPDK_FILESYSTEM_POSIX_HH
@@ -68,6 +68,24 @@ bool FileSystem::hasFileHandler(const char *pathname) {
     return m_FileHandlers.find(pathname) != m_FileHandlers.end();
 }
 
+int FileSystem::readBatch(FileSystemRead *reqs, uint16_t n) {
+    int ok = 0;
+    for (uint16_t i = 0; i < n; ++i) {
+        reqs[i].result = this->read(reqs[i].pathname, reqs[i].buf,
+                                    reqs[i].count, reqs[i].offset);
+        ok += (int)(reqs[i].result >= 0);
+    }
+    return ok;
+}
+
+int FileSystem::setDirectIO(bool enable) {
+    if (enable) {
+        ZF_LOGW("Direct I/O is not supported by this filesystem");
+        return FILESYSTEM_EFAILURE;
+    }
+    return FILESYSTEM_ESUCCESS;
+}
+
 void FileSystem::startGarbageCollector() {
     ZF_LOGV("Starting file descriptors garbage collector thread");
     m_garbageCollectorThread = thread(&FileSystem::onGarbageCollector, this);
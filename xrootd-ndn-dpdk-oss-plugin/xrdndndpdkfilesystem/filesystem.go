@@ -39,6 +39,20 @@ func GetFilesystem(_type string) (fileSystem unsafe.Pointer, e error) {
 	return fileSystem, nil
 }
 
+// SetDirectIO bypasses the page cache on filesystem object
+func SetDirectIO(fileSystem unsafe.Pointer, enable bool) error {
+	var flag C.int
+	if enable {
+		flag = 1
+	}
+
+	if C.libfs_setDirectIO(fileSystem, flag) != 0 {
+		return fmt.Errorf("Unable to set direct I/O on filesystem object")
+	}
+
+	return nil
+}
+
 // FreeFilesystem object
 func FreeFilesystem(fileSystem unsafe.Pointer) {
 	C.libfs_destroyFilesystem(fileSystem)
@@ -34,6 +34,7 @@
 #include <sys/types.h>
 
 #include "../xrdndndpdk-logger/logger.hh"
+#include "filesystem-c-api.h"
 #include "filesystem-namespace.hh"
 
 #define likely(x) __builtin_expect((x), 1)
@@ -78,6 +79,22 @@ class FileSystem {
                      off_t offset = 0) = 0;
     virtual void close(const char *pathname, std::any fd) = 0;
 
+    /**
+     * @brief Read a batch of requests. The default implementation issues one
+     * read() per request
+     *
+     * @return int Number of requests that completed without error
+     */
+    virtual int readBatch(FileSystemRead *reqs, uint16_t n);
+
+    /**
+     * @brief Bypass the page cache on files opened from now on
+     *
+     * @return int FILESYSTEM_ESUCCESS or FILESYSTEM_EFAILURE if the
+     * filesystem does not support direct I/O
+     */
+    virtual int setDirectIO(bool enable);
+
   protected:
     int storeFileHandler(const char *pathname, std::any fd);
     std::any getFileHandler(const char *pathname);
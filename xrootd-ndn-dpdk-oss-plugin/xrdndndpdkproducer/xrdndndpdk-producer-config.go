@@ -16,4 +16,8 @@ type ProducerSettings struct {
 	FreshnessPeriod nnduration.Milliseconds // FreshnessPeriod value
 	RxQueue         iface.PktQueueConfig
 	FilesystemType  string
+	DirectIO        bool // Bypass the page cache, posix filesystem with io_uring only
+
+	// RX queue depth above which Data is congestion marked, default a quarter of the queue capacity
+	CongestionMarkDepth int
 }
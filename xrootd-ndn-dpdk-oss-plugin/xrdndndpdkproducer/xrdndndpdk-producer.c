@@ -18,6 +18,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.     *
  *****************************************************************************/
 
+#include <string.h>
 #include <sys/stat.h>
 
 #include "../xrdndndpdk-common/xrdndndpdk-data.h"
@@ -126,10 +127,13 @@ static Packet *Producer_OnFileInfoInterest(Producer *producer, Packet *npkt,
     return pkt;
 }
 
-static Packet *Producer_OnReadInterest(Producer *producer, Packet *npkt,
-                                       const LName name) {
-    char *pathname =
-        rte_malloc(NULL, XRDNDNDPDK_MAX_NAME_SIZE * sizeof(char), 0);
+/**
+ * @brief Decode READ Interest into a filesystem read request. The pathname and
+ * buffer of the request are preallocated by the caller
+ *
+ */
+static void Producer_PrepareRead(const LName name, FileSystemRead *req) {
+    char *pathname = (char *)req->pathname;
     const uint8_t *offsetNumComp = RTE_PTR_ADD(
         name.value,
         Name_Decode_FilePath(name, PACKET_NAME_PREFIX_URI_READ_ENCODED_LEN,
@@ -137,33 +141,41 @@ static Packet *Producer_OnReadInterest(Producer *producer, Packet *npkt,
 
     ZF_LOGV("On READ Interest for file: %s", pathname);
 
-    void *buf =
-        rte_malloc(NULL, sizeof(uint8_t) * XRDNDNDPDK_MAX_PAYLOAD_SIZE, 0);
-    if (unlikely(NULL == buf)) {
-        ZF_LOGF("Not enough memory to alloc read buffer of size %d",
-                XRDNDNDPDK_MAX_PAYLOAD_SIZE);
-        rte_free(pathname);
-        return Producer_EncodeDataAsError(producer, npkt, XRDNDNDPDK_EFAILURE);
-    }
-
     assert(offsetNumComp[0] == TtByteOffsetNameComponent);
     uint64_t offset = 0;
     Nni_Decode(offsetNumComp[1], RTE_PTR_ADD(offsetNumComp, 2), &offset);
 
-    int readRetCode = libfs_read(producer->fs, pathname, buf,
-                                 XRDNDNDPDK_MAX_PAYLOAD_SIZE, offset);
+    req->offset = offset;
+    req->count = XRDNDNDPDK_MAX_PAYLOAD_SIZE;
+    req->result = 0;
+}
 
-    if (unlikely(readRetCode < 0)) {
-        rte_free(buf);
-        rte_free(pathname);
-        return Producer_EncodeDataAsError(producer, npkt, -readRetCode);
+/**
+ * @brief Find an earlier read of the same burst for the same file and offset
+ *
+ * @return uint16_t Index of the read that will fetch the content, n if none
+ */
+static uint16_t Producer_FindRead(const FileSystemRead *reads,
+                                  const uint16_t *readOwner, uint16_t n,
+                                  const FileSystemRead *req) {
+    for (uint16_t i = 0; i < n; ++i) {
+        if (readOwner[i] == i && reads[i].offset == req->offset &&
+            strcmp(reads[i].pathname, req->pathname) == 0) {
+            ZF_LOGV("Coalesce READ Interest for file: %s", req->pathname);
+            return i;
+        }
     }
+    return n;
+}
 
-    Packet *pkt =
-        Producer_EncodeData(producer, npkt, readRetCode, (uint8_t *)buf);
-    rte_free(buf);
-    rte_free(pathname);
-    return pkt;
+static Packet *Producer_OnReadComplete(Producer *producer, Packet *npkt,
+                                       const FileSystemRead *req) {
+    if (unlikely(req->result < 0)) {
+        return Producer_EncodeDataAsError(producer, npkt, -req->result);
+    }
+
+    return Producer_EncodeData(producer, npkt, req->result,
+                               (uint8_t *)req->buf);
 }
 
 typedef Packet *(*OnInterest)(Producer *producer, Packet *npkt,
@@ -171,14 +183,12 @@ typedef Packet *(*OnInterest)(Producer *producer, Packet *npkt,
 
 static const OnInterest onInterest[PACKET_MAX] = {
     [PACKET_FILEINFO] = Producer_OnFileInfoInterest,
-    [PACKET_READ] = Producer_OnReadInterest,
+    // READ Interests are batched in Producer_Run
 };
-static Packet *Producer_processInterest(Producer *producer, Packet *npkt) {
+static Packet *Producer_processInterest(Producer *producer, Packet *npkt,
+                                        const LName *name, PacketType pt) {
     ZF_LOGD("Processing Interest packet");
 
-    const LName *name = (const LName *)&Packet_GetInterestHdr(npkt)->name;
-    PacketType pt = Name_Decode_PacketType(*name);
-
     if (unlikely(pt == PACKET_NOT_SUPPORTED)) {
         ZF_LOGW("Unsupported packet type");
         return Nack_FromInterest(npkt, NackNoRoute);
@@ -196,12 +206,39 @@ void Producer_Run(Producer *producer) {
     ZF_LOGI("Started producer instance on socket: %d lcore %d", rte_socket_id(),
             rte_lcore_id());
 
-    struct rte_mbuf *rx[producer->rxQueue.dequeueBurstSize];
-    Packet *tx[producer->rxQueue.dequeueBurstSize];
+    uint16_t burstSize = producer->rxQueue.dequeueBurstSize;
+    struct rte_mbuf *rx[burstSize];
+    Packet *tx[burstSize];
+    Packet *readPkts[burstSize];
+    uint16_t readOwner[burstSize];
+
+    // One read request slot per Interest of a burst, so that all READ
+    // Interests of a burst reach the filesystem as a single batch
+    FileSystemRead *reads =
+        rte_malloc(NULL, burstSize * sizeof(FileSystemRead), 0);
+    FileSystemRead *uniqueReads =
+        rte_malloc(NULL, burstSize * sizeof(FileSystemRead), 0);
+    char *pathnames = rte_malloc(NULL, burstSize * XRDNDNDPDK_MAX_NAME_SIZE, 0);
+    uint8_t *bufs = rte_malloc(NULL, burstSize * XRDNDNDPDK_MAX_PAYLOAD_SIZE,
+                               RTE_CACHE_LINE_SIZE);
+    if (unlikely(reads == NULL || uniqueReads == NULL || pathnames == NULL ||
+                 bufs == NULL)) {
+        ZF_LOGF("Not enough memory to alloc read requests for burst size %d",
+                burstSize);
+        rte_free(reads);
+        rte_free(uniqueReads);
+        rte_free(pathnames);
+        rte_free(bufs);
+        return;
+    }
+
+    for (uint16_t i = 0; i < burstSize; ++i) {
+        reads[i].pathname = &pathnames[i * XRDNDNDPDK_MAX_NAME_SIZE];
+        reads[i].buf = &bufs[i * XRDNDNDPDK_MAX_PAYLOAD_SIZE];
+    }
 
     while (ThreadStopFlag_ShouldContinue(&producer->stop)) {
-        uint32_t nRx = PktQueue_Pop(&producer->rxQueue, rx,
-                                    producer->rxQueue.dequeueBurstSize,
+        uint32_t nRx = PktQueue_Pop(&producer->rxQueue, rx, burstSize,
                                     rte_get_tsc_cycles())
                            .count;
 
@@ -210,14 +247,68 @@ void Producer_Run(Producer *producer) {
             continue;
         }
 
+        // Interests still waiting once this burst is served. Data is only
+        // marked: the consumer treats any Nack as a failed read
+        uint32_t depth = rte_ring_count(producer->rxQueue.ring);
+        bool congMark = depth > producer->congMarkDepth;
+
         uint16_t nTx = 0;
+        uint16_t nRead = 0;
         for (uint16_t i = 0; i < nRx; ++i) {
             Packet *npkt = Packet_FromMbuf(rx[i]);
             NDNDPDK_ASSERT(Packet_GetType(npkt) == PktInterest);
-            tx[nTx] = Producer_processInterest(producer, npkt);
+
+            const LName *name =
+                (const LName *)&Packet_GetInterestHdr(npkt)->name;
+            PacketType pt = Name_Decode_PacketType(*name);
+
+            if (pt == PACKET_READ) {
+                Producer_PrepareRead(*name, &reads[nRead]);
+                readOwner[nRead] =
+                    Producer_FindRead(reads, readOwner, nRead, &reads[nRead]);
+                readPkts[nRead++] = npkt;
+                continue;
+            }
+
+            tx[nTx] = Producer_processInterest(producer, npkt, name, pt);
             nTx += (int)(tx[nTx] != NULL);
         }
 
+        if (nRead > 0) {
+            // Only the first request for each (path, offset) reaches storage
+            uint16_t nUnique = 0;
+            for (uint16_t i = 0; i < nRead; ++i) {
+                if (readOwner[i] == i) {
+                    uniqueReads[nUnique++] = reads[i];
+                }
+            }
+            libfs_readBatch(producer->fs, uniqueReads, nUnique);
+            for (uint16_t i = 0, u = 0; i < nRead; ++i) {
+                if (readOwner[i] == i) {
+                    reads[i].result = uniqueReads[u++].result;
+                }
+            }
+
+            for (uint16_t i = 0; i < nRead; ++i) {
+                tx[nTx] = Producer_OnReadComplete(producer, readPkts[i],
+                                                  &reads[readOwner[i]]);
+                nTx += (int)(tx[nTx] != NULL);
+            }
+        }
+
+        if (unlikely(congMark)) {
+            for (uint16_t i = 0; i < nTx; ++i) {
+                if (Packet_GetType(tx[i]) == PktSData) {
+                    Packet_GetLpL3Hdr(tx[i])->congMark = 1;
+                }
+            }
+        }
+
         Face_TxBurst(producer->face, tx, nTx);
     }
+
+    rte_free(reads);
+    rte_free(uniqueReads);
+    rte_free(pathnames);
+    rte_free(bufs);
 }
@@ -35,6 +35,14 @@ func NewProducer(face iface.Face, settings ProducerSettings) (producer *Producer
 		return nil, e
 	}
 
+	if settings.DirectIO {
+		if e = xrdndndpdkfilesystem.SetDirectIO(producer.fileSystem, true); e != nil {
+			xrdndndpdkfilesystem.FreeFilesystem(producer.fileSystem)
+			eal.Free(producer.c)
+			return nil, e
+		}
+	}
+
 	settings.RxQueue.DisableCoDel = true
 	if e := iface.PktQueueFromPtr(unsafe.Pointer(&producer.c.rxQueue)).Init(settings.RxQueue, socket); e != nil {
 		eal.Free(producer.c)
@@ -57,6 +65,12 @@ func NewProducer(face iface.Face, settings ProducerSettings) (producer *Producer
 func (producer *Producer) Configure(settings ProducerSettings) (e error) {
 	producer.c.fs = producer.fileSystem
 	producer.c.freshnessPeriod = C.uint32_t(settings.FreshnessPeriod.Duration() / time.Millisecond)
+
+	capacity := int(C.rte_ring_get_capacity(producer.c.rxQueue.ring))
+	if settings.CongestionMarkDepth <= 0 {
+		settings.CongestionMarkDepth = capacity / 4
+	}
+	producer.c.congMarkDepth = C.uint32_t(settings.CongestionMarkDepth)
 	return nil
 }
 
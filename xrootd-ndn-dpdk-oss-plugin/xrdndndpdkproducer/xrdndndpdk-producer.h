@@ -48,6 +48,8 @@ typedef struct Producer {
     FaceID face;
 
     uint32_t freshnessPeriod;
+    // RX queue depth above which Data is congestion marked
+    uint32_t congMarkDepth;
     ThreadStopFlag stop;
 
     void *fs;
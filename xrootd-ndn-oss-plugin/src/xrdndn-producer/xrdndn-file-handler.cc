@@ -23,14 +23,18 @@ using namespace ndn;
 namespace xrdndnproducer {
 std::shared_ptr<FileHandler>
 FileHandler::getFileHandler(const std::string path,
-                            const std::shared_ptr<Packager> &packager) {
-    auto fh = std::make_shared<FileHandler>(path, packager);
+                            const std::shared_ptr<Packager> &packager,
+                            size_t dataCacheSize) {
+    auto fh = std::make_shared<FileHandler>(path, packager, dataCacheSize);
     return fh;
 }
 
 FileHandler::FileHandler(const std::string path,
-                         const std::shared_ptr<Packager> &packager)
-    : m_fd(XRDNDN_EFAILURE), m_path(path), m_packager(packager) {
+                         const std::shared_ptr<Packager> &packager,
+                         size_t dataCacheSize)
+    : m_fd(XRDNDN_EFAILURE), m_path(path), m_packager(packager),
+      m_dataCacheSize(dataCacheSize), m_dataCacheMtime{},
+      m_dataCacheFileSize(0) {
     accessTime = boost::posix_time::second_clock::local_time();
     Open();
 }
@@ -109,15 +113,21 @@ int FileHandler::Fstat(void *buff) {
 std::shared_ptr<ndn::Data> FileHandler::getReadData(ndn::Name &name) {
     accessTime = boost::posix_time::second_clock::local_time();
 
+    auto segment = xrdndn::Utils::getSegmentNo(name);
+    if (auto data = getCachedData(segment)) {
+        return data;
+    }
+
     std::array<uint8_t, XRDNDN_MAX_PAYLOAD_SIZE> blockFromFile;
-    auto retRead =
-        Read(&blockFromFile, XRDNDN_MAX_PAYLOAD_SIZE,
-             xrdndn::Utils::getSegmentNo(name) * XRDNDN_MAX_PAYLOAD_SIZE);
+    auto retRead = Read(&blockFromFile, XRDNDN_MAX_PAYLOAD_SIZE,
+                        segment * XRDNDN_MAX_PAYLOAD_SIZE);
 
     if (retRead < 0) {
         return m_packager->getPackage(name, retRead);
     } else {
-        return m_packager->getPackage(name, blockFromFile.data(), retRead);
+        auto data = m_packager->getPackage(name, blockFromFile.data(), retRead);
+        cacheData(segment, data);
+        return data;
     }
 }
 
@@ -132,4 +142,64 @@ ssize_t FileHandler::Read(void *buff, size_t count, off_t offset) {
 
     return ret;
 }
+
+std::shared_ptr<ndn::Data> FileHandler::getCachedData(uint64_t segment) {
+    if (m_dataCacheSize == 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(m_fd, &st) == XRDNDN_EFAILURE) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_dataCacheMtx);
+
+    if (st.st_size != m_dataCacheFileSize ||
+        st.st_mtim.tv_sec != m_dataCacheMtime.tv_sec ||
+        st.st_mtim.tv_nsec != m_dataCacheMtime.tv_nsec) {
+        if (!m_dataCache.empty()) {
+            NDN_LOG_INFO("File: " << m_path
+                                  << " changed, dropping cached Data");
+        }
+        m_dataCache.clear();
+        m_dataCacheLru.clear();
+        m_dataCacheMtime = st.st_mtim;
+        m_dataCacheFileSize = st.st_size;
+        return nullptr;
+    }
+
+    auto it = m_dataCache.find(segment);
+    if (it == m_dataCache.end()) {
+        return nullptr;
+    }
+
+    m_dataCacheLru.splice(m_dataCacheLru.begin(), m_dataCacheLru,
+                          it->second.second);
+    return it->second.first;
+}
+
+void FileHandler::cacheData(uint64_t segment,
+                            const std::shared_ptr<ndn::Data> &data) {
+    if (m_dataCacheSize == 0) {
+        return;
+    }
+
+    // Encode once here so that every Face::put of this Data reuses the wire
+    data->wireEncode();
+
+    std::lock_guard<std::mutex> lock(m_dataCacheMtx);
+
+    if (m_dataCache.find(segment) != m_dataCache.end()) {
+        return;
+    }
+
+    if (m_dataCache.size() >= m_dataCacheSize) {
+        m_dataCache.erase(m_dataCacheLru.back());
+        m_dataCacheLru.pop_back();
+    }
+
+    m_dataCacheLru.push_front(segment);
+    m_dataCache.emplace(segment, std::make_pair(data, m_dataCacheLru.begin()));
+}
 } // namespace xrdndnproducer
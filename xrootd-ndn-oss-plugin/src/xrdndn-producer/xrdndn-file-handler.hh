@@ -9,6 +9,10 @@
 #ifndef XRDNDN_FILE_HANDLER
 #define XRDNDN_FILE_HANDLER
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "xrdndn-packager.hh"
@@ -26,20 +30,24 @@ class FileHandler : public std::enable_shared_from_this<FileHandler> {
      *
      * @param path Path to the file
      * @param packager Packager instance object
+     * @param dataCacheSize Number of signed read Data packets to keep
      * @return std::shared_ptr<FileHandler> A FileHandler object as shared_ptr
      */
     static std::shared_ptr<FileHandler>
     getFileHandler(const std::string path,
-                   const std::shared_ptr<Packager> &packager);
+                   const std::shared_ptr<Packager> &packager,
+                   size_t dataCacheSize = 0);
 
     /**
      * @brief Construct a new File Handler object
      *
      * @param path Path to the file
      * @param packager Packager instance object
+     * @param dataCacheSize Number of signed read Data packets to keep
      */
     FileHandler(const std::string path,
-                const std::shared_ptr<Packager> &packager);
+                const std::shared_ptr<Packager> &packager,
+                size_t dataCacheSize = 0);
 
     /**
      * @brief Destroy the File Handler object
@@ -123,11 +131,39 @@ class FileHandler : public std::enable_shared_from_this<FileHandler> {
      */
     ssize_t Read(void *buff, size_t count, off_t offset);
 
+    /**
+     * @brief Look up the signed Data of a segment. The whole cache is dropped
+     * when the file size or modification time changed
+     *
+     * @param segment The segment number
+     * @return std::shared_ptr<ndn::Data> The cached Data or nullptr
+     */
+    std::shared_ptr<ndn::Data> getCachedData(uint64_t segment);
+
+    /**
+     * @brief Keep the signed Data of a segment, evicting the least recently
+     * used one when the cache is full
+     *
+     * @param segment The segment number
+     * @param data The signed Data packet
+     */
+    void cacheData(uint64_t segment, const std::shared_ptr<ndn::Data> &data);
+
   private:
     boost::posix_time::ptime accessTime;
     int m_fd;
     const std::string m_path;
     const std::shared_ptr<Packager> m_packager;
+
+    const size_t m_dataCacheSize;
+    std::list<uint64_t> m_dataCacheLru;
+    std::unordered_map<
+        uint64_t,
+        std::pair<std::shared_ptr<ndn::Data>, std::list<uint64_t>::iterator>>
+        m_dataCache;
+    struct timespec m_dataCacheMtime;
+    off_t m_dataCacheFileSize;
+    std::mutex m_dataCacheMtx;
 };
 } // namespace xrdndnproducer
 
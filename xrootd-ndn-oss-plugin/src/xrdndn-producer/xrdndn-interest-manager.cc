@@ -6,6 +6,8 @@
 // This software is released under the MIT License.
 // https://opensource.org/licenses/MIT
 
+#include <ndn-cxx/lp/tags.hpp>
+
 #include "../common/xrdndn-logger.hh"
 #include "../common/xrdndn-namespace.hh"
 #include "../common/xrdndn-utils.hh"
@@ -16,9 +18,11 @@ using namespace ndn;
 
 namespace xrdndnproducer {
 InterestManager::InterestManager(const Options &opts,
-                                 onDataCallback dataCallback)
-    : m_ioServiceWork(m_ioService), m_options(opts) {
+                                 onDataCallback dataCallback,
+                                 onNackCallback nackCallback)
+    : m_ioServiceWork(m_ioService), m_options(opts), m_pending(0) {
     m_onDataCallback = std::move(dataCallback);
+    m_onNackCallback = std::move(nackCallback);
     m_packager = std::make_shared<Packager>(m_options.freshnessPeriod,
                                             m_options.disableSigning);
 
@@ -52,7 +56,8 @@ std::shared_ptr<FileHandler> InterestManager::getFileHandler(std::string path) {
         return it->second->shared_from_this();
     }
 
-    auto fh = FileHandler::getFileHandler(path, m_packager->shared_from_this());
+    auto fh = FileHandler::getFileHandler(path, m_packager->shared_from_this(),
+                                          m_options.dataCacheSize);
     if (!fh) {
         NDN_LOG_WARN("Unable to get FileHandler object for file: " << path);
         return std::shared_ptr<FileHandler>(nullptr);
@@ -84,8 +89,20 @@ void InterestManager::onGarbageCollector() {
         std::bind(&InterestManager::onGarbageCollector, this));
 }
 
+void InterestManager::post(std::function<void()> task) {
+    ++m_pending;
+    m_ioService.post([this, task = std::move(task)] {
+        task();
+        --m_pending;
+    });
+}
+
+bool InterestManager::isCongested() const {
+    return m_options.maxPending > 0 && m_pending > m_options.maxPending / 2;
+}
+
 void InterestManager::openInterest(const Interest &interest) {
-    m_ioService.post([&] {
+    post([&] {
         Name name = interest.getName();
 
         std::string path = xrdndn::Utils::getPath(name);
@@ -101,7 +118,7 @@ void InterestManager::openInterest(const Interest &interest) {
 }
 
 void InterestManager::fstatInterest(const Interest &interest) {
-    m_ioService.post([&] {
+    post([&] {
         Name name = interest.getName();
 
         std::string path = xrdndn::Utils::getPath(name);
@@ -117,18 +134,44 @@ void InterestManager::fstatInterest(const Interest &interest) {
 }
 
 void InterestManager::readInterest(const Interest &interest) {
-    m_ioService.post([&] {
-        Name name = interest.getName();
+    Name name = interest.getName();
+
+    // Shed load rather than queue reads that would time out anyway; open and
+    // fstat Interests are cheap and always served
+    if (m_options.maxPending > 0 && m_pending >= m_options.maxPending) {
+        NDN_LOG_DEBUG("Too many pending Interests, Nack: " << name);
+        m_onNackCallback(
+            lp::Nack(interest).setReason(lp::NackReason::CONGESTION));
+        return;
+    }
 
-        std::string path = xrdndn::Utils::getPath(name);
-        if (path.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_inflightReadsMtx);
+        if (!m_inflightReads.insert(name).second) {
+            NDN_LOG_TRACE("Read already in progress for: " << name);
             return;
+        }
+    }
 
-        auto fh = getFileHandler(path);
-        auto data = fh ? fh->getReadData(name)
-                       : m_packager->getPackage(name, XRDNDN_EFAILURE);
+    post([this, name]() mutable {
+        std::string path = xrdndn::Utils::getPath(name);
 
-        m_onDataCallback(data);
+        if (!path.empty()) {
+            auto fh = getFileHandler(path);
+            auto data = fh ? fh->getReadData(name)
+                           : m_packager->getPackage(name, XRDNDN_EFAILURE);
+
+            // Cached Data is shared, mark a copy
+            if (data && isCongested()) {
+                data = std::make_shared<Data>(*data);
+                data->setTag(std::make_shared<lp::CongestionMarkTag>(1));
+            }
+
+            m_onDataCallback(data);
+        }
+
+        std::lock_guard<std::mutex> lock(m_inflightReadsMtx);
+        m_inflightReads.erase(name);
     });
 }
 } // namespace xrdndnproducer
\ No newline at end of file
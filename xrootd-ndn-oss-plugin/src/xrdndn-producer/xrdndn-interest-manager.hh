@@ -9,13 +9,18 @@
 #ifndef XRDNDN_INTEREST_MANAGER_HH
 #define XRDNDN_INTEREST_MANAGER_HH
 
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/system_timer.hpp>
 #include <boost/thread/condition.hpp>
 #include <boost/thread/thread.hpp>
 
+#include <ndn-cxx/lp/nack.hpp>
+
 #include "xrdndn-file-handler.hh"
 #include "xrdndn-producer-options.hh"
 
@@ -28,6 +33,7 @@ namespace xrdndnproducer {
  */
 class InterestManager {
     using onDataCallback = std::function<void(std::shared_ptr<ndn::Data> data)>;
+    using onNackCallback = std::function<void(const ndn::lp::Nack &nack)>;
 
   public:
     /**
@@ -36,8 +42,11 @@ class InterestManager {
      * @param opts Producer command line arguments
      * @param dataCallback The callback function to be called for putting Data
      * on Face
+     * @param nackCallback The callback function to be called for putting Nack
+     * on Face when the thread pool is overloaded
      */
-    InterestManager(const Options &opts, onDataCallback dataCallback);
+    InterestManager(const Options &opts, onDataCallback dataCallback,
+                    onNackCallback nackCallback);
 
     /**
      * @brief Destroy the Interest Manager object
@@ -86,8 +95,25 @@ class InterestManager {
      */
     void onGarbageCollector();
 
+    /**
+     * @brief Post a task to the thread pool, keeping count of the Interests
+     * waiting to be processed
+     *
+     * @param task The task processing one Interest
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * @brief Check whether Data should be congestion marked because the
+     * thread pool is falling behind
+     *
+     * @return true More than half of max-pending Interests are waiting
+     */
+    bool isCongested() const;
+
   private:
     onDataCallback m_onDataCallback;
+    onNackCallback m_onNackCallback;
 
     boost::asio::io_service m_ioService;
     boost::asio::io_service::work m_ioServiceWork;
@@ -100,6 +126,14 @@ class InterestManager {
     std::unordered_map<std::string, std::shared_ptr<FileHandler>>
         m_FileHandlers;
     mutable boost::shared_mutex m_FileHandlersMtx;
+
+    // Names of read Interests being served. The forwarder satisfies every
+    // pending Interest for a Name with one Data, so duplicates are dropped
+    std::unordered_set<ndn::Name> m_inflightReads;
+    std::mutex m_inflightReadsMtx;
+
+    // Interests posted to the thread pool and not yet processed
+    std::atomic<uint32_t> m_pending;
 };
 } // namespace xrdndnproducer
 
@@ -8,6 +8,9 @@
 
 #include <cstdlib>
 
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/util/sha256.hpp>
+
 #include "../common/xrdndn-logger.hh"
 #include "../common/xrdndn-namespace.hh"
 #include "xrdndn-packager.hh"
@@ -15,13 +18,6 @@
 using namespace ndn;
 
 namespace xrdndnproducer {
-const security::SigningInfo Packager::signingInfo =
-    static_cast<security::SigningInfo>(
-        security::SigningInfo::SignerType::SIGNER_TYPE_SHA256);
-
-const std::shared_ptr<ndn::KeyChain> Packager::keyChain =
-    std::make_shared<KeyChain>();
-
 Packager::Packager(uint64_t freshnessPeriod, bool disableSignature)
     : m_freshnessPeriod(freshnessPeriod), m_disableSigning(disableSignature) {
     if (disableSignature) {
@@ -29,6 +25,8 @@ Packager::Packager(uint64_t freshnessPeriod, bool disableSignature)
             SignatureInfo(static_cast<ndn::tlv::SignatureTypeValue>(255));
         m_fakeSignature.setInfo(sigInfo);
         m_fakeSignature.setValue(makeEmptyBlock(ndn::tlv::SignatureValue));
+    } else {
+        m_digestSignature.setInfo(SignatureInfo(tlv::DigestSha256));
     }
 }
 
@@ -38,12 +36,23 @@ void Packager::digest(std::shared_ptr<ndn::Data> data) {
     data->setFreshnessPeriod(m_freshnessPeriod);
 
     if (!m_disableSigning) {
-        keyChain->sign(*data, signingInfo);
+        signDigestSha256(*data);
     } else {
         data->setSignature(m_fakeSignature);
     }
 }
 
+void Packager::signDigestSha256(ndn::Data &data) {
+    data.setSignature(m_digestSignature);
+
+    EncodingBuffer encoder;
+    data.wireEncode(encoder, true);
+
+    // OpenSSL picks the SHA-NI/AVX2 implementation available on this CPU
+    auto digest = util::Sha256::computeDigest(encoder.buf(), encoder.size());
+    data.wireEncode(encoder, Block(tlv::SignatureValue, digest));
+}
+
 std::shared_ptr<ndn::Data> Packager::getPackage(ndn::Name &name,
                                                 const int contentValue) {
     auto data = std::make_shared<ndn::Data>(name);
@@ -11,8 +11,6 @@
 
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/name.hpp>
-#include <ndn-cxx/security/key-chain.hpp>
-#include <ndn-cxx/security/signing-info.hpp>
 
 namespace xrdndnproducer {
 /**
@@ -21,17 +19,6 @@ namespace xrdndnproducer {
  *
  */
 class Packager : public std::enable_shared_from_this<Packager> {
-    /**
-     * @brief NDN SigningInfo for signing Data used by key chain
-     *
-     */
-    static const ndn::security::SigningInfo signingInfo;
-    /**
-     * @brief NDN Key Chain for signing Data
-     *
-     */
-    static const std::shared_ptr<ndn::KeyChain> keyChain;
-
   public:
     /**
      * @brief Construct a new Packager object
@@ -78,10 +65,20 @@ class Packager : public std::enable_shared_from_this<Packager> {
      */
     void digest(std::shared_ptr<ndn::Data> data);
 
+    /**
+     * @brief Sign Data with a SHA-256 digest in a single encoding pass. Gives
+     * the same packet as KeyChain::sign with a SHA-256 signer, without the
+     * KeyChain lookups and without opening a PIB/TPM
+     *
+     * @param data The Data to be signed
+     */
+    void signDigestSha256(ndn::Data &data);
+
   private:
     const ndn::time::milliseconds m_freshnessPeriod;
     bool m_disableSigning;
     ndn::Signature m_fakeSignature;
+    ndn::Signature m_digestSignature;
 };
 } // namespace xrdndnproducer
 
@@ -64,6 +64,11 @@ int main(int argc, char **argv) {
     description.add_options()(
         "config-file", boost::program_options::value<std::string>(&configFile),
         "Configuration file for running xrdndn-producer as a service")(
+        "data-cache-size",
+        boost::program_options::value<uint32_t>(&opts.dataCacheSize)
+            ->default_value(opts.dataCacheSize),
+        "Number of signed Data packets kept in memory for each open file. "
+        "Specify 0 to read and sign every request")(
         "disable-signing",
         boost::program_options::bool_switch(&opts.disableSigning),
         "Eliminate signing among authorized partners by signing Data with a "
@@ -92,6 +97,12 @@ int main(int argc, char **argv) {
         "accessed. Once the limit is reached and garbage-collector-timer "
         "triggers, the file will be closed")(
         "help,h", "Print this help message and exit")(
+        "max-pending",
+        boost::program_options::value<uint32_t>(&opts.maxPending)
+            ->default_value(opts.maxPending),
+        "Maximum number of Interests waiting to be processed. Beyond half of "
+        "it read Data is congestion marked, at the limit read Interests are "
+        "Nacked with reason Congestion. Specify 0 to queue every Interest")(
         "log-level",
         boost::program_options::value<std::string>(&logLevel)
             ->default_value(logLevel)
@@ -204,7 +215,9 @@ int main(int argc, char **argv) {
                      << "sec, Garbage collector lifetime: "
                      << opts.gbFileLifeTime
                      << "sec, Number of threads: " << opts.nthreads
-                     << ", SHA-256 signing disabled: " << opts.disableSigning);
+                     << ", SHA-256 signing disabled: " << opts.disableSigning
+                     << ", Data cache size: " << opts.dataCacheSize
+                     << ", Max pending Interests: " << opts.maxPending);
     }
 
     return run(opts);
@@ -33,6 +33,20 @@ namespace xrdndnproducer {
  */
 #define XRDNDN_GB_DEFAULT_TIMEPERIOD 256
 
+/**
+ * @brief The default number of signed Data packets kept in memory for each
+ * open file
+ *
+ */
+#define XRDNDN_DATA_CACHE_DEFAULT_SIZE 1024
+
+/**
+ * @brief The default number of Interests waiting for the Interest Manager
+ * thread pool above which read Interests are Nacked with reason Congestion
+ *
+ */
+#define XRDNDN_INTERESTMANAGER_DEFAULT_MAX_PENDING 1024
+
 /**
  * @brief XRootD NDN Producer options from command line
  *
@@ -82,6 +96,22 @@ struct Options {
      *
      */
     bool disableSigning = false;
+
+    /**
+     * @brief Number of signed read Data packets kept for each open file, so
+     * that repeated requests for the same segment are not read and signed
+     * again. 0 disables the cache
+     *
+     */
+    uint32_t dataCacheSize = XRDNDN_DATA_CACHE_DEFAULT_SIZE;
+
+    /**
+     * @brief Maximum number of Interests waiting for the thread pool. Beyond
+     * half of it read Data is congestion marked, and at the limit read
+     * Interests are Nacked with reason Congestion. 0 disables the limit
+     *
+     */
+    uint32_t maxPending = XRDNDN_INTERESTMANAGER_DEFAULT_MAX_PENDING;
 };
 } // namespace xrdndnproducer
 
@@ -37,7 +37,8 @@ Producer::Producer(Face &face, const Options &opts)
     }
 
     m_interestManager = std::make_shared<InterestManager>(
-        opts, std::bind(&Producer::onData, this, _1));
+        opts, std::bind(&Producer::onData, this, _1),
+        std::bind(&Producer::onNack, this, _1));
 
     if (!m_interestManager) {
         NDN_LOG_FATAL("Unable to get Interest Manager object instance");
@@ -93,6 +94,12 @@ void Producer::onData(std::shared_ptr<ndn::Data> data) {
     m_face.put(*data);
 }
 
+void Producer::onNack(const lp::Nack &nack) {
+    NDN_LOG_TRACE("Sending Nack: " << nack.getReason() << " for Interest: "
+                                   << nack.getInterest());
+    m_face.put(nack);
+}
+
 void Producer::onOpenInterest(const InterestFilter &,
                               const Interest &interest) {
     NDN_LOG_TRACE("onOpenInterest: " << interest);
@@ -63,6 +63,13 @@ class Producer : boost::noncopyable {
      */
     void onData(std::shared_ptr<ndn::Data> data);
 
+    /**
+     * @brief Function called be InterestManager object to put Nack on Face
+     *
+     * @param nack The Nack to be sent back to the Consumer
+     */
+    void onNack(const ndn::lp::Nack &nack);
+
     /**
      * @brief Function called when Interest for open system call is received on
      * Face